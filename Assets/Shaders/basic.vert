@@ -2,11 +2,27 @@
 
 layout (location = 0) in vec3 aPos;
 
+// Per-frame data shared by all scene shaders (std140, binding 0)
+layout (std140) uniform FrameData
+{
+    mat4 view;
+    mat4 projection;
+    vec3 lightPos;
+    float lightIntensity;
+    vec3 lightColor;
+    bool lightEnabled;
+    vec3 viewPos;
+};
+
 uniform mat4 model;
-uniform mat4 view;
-uniform mat4 projection;
+
+// Overlay geometry (crosshair) is already in clip space
+uniform bool uOverlay;
 
 void main()
 {
-    gl_Position = projection * view * model * vec4(aPos, 1.0);
+    if (uOverlay)
+        gl_Position = model * vec4(aPos, 1.0);
+    else
+        gl_Position = projection * view * model * vec4(aPos, 1.0);
 }
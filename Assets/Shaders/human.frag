@@ -5,21 +5,25 @@ out vec4 FragColor;
 in vec3 FragPos;
 in vec3 Normal;
 in vec2 TexCoord;
+flat in float TexLayer;
 
-uniform sampler2D uTexture;
+uniform sampler2DArray uTextures;
 
-// Light properties
-uniform vec3 lightPos;
-uniform vec3 lightColor;
-uniform float lightIntensity;
-uniform bool lightEnabled;
-
-// View position (camera)
-uniform vec3 viewPos;
+// Per-frame data shared by all scene shaders (std140, binding 0)
+layout (std140) uniform FrameData
+{
+    mat4 view;
+    mat4 projection;
+    vec3 lightPos;
+    float lightIntensity;
+    vec3 lightColor;
+    bool lightEnabled;
+    vec3 viewPos;
+};
 
 void main()
 {
-    vec3 texColor = texture(uTexture, TexCoord).rgb;
+    vec3 texColor = texture(uTextures, vec3(TexCoord, TexLayer)).rgb;
 
     if (!lightEnabled)
     {
@@ -7,16 +7,28 @@ layout (location = 2) in vec2 aTexCoord;
 out vec3 FragPos;
 out vec3 Normal;
 out vec2 TexCoord;
+flat out float TexLayer;
 
 uniform mat4 model;
-uniform mat4 view;
-uniform mat4 projection;
+uniform float uLayer;
+// Per-frame data shared by all scene shaders (std140, binding 0)
+layout (std140) uniform FrameData
+{
+    mat4 view;
+    mat4 projection;
+    vec3 lightPos;
+    float lightIntensity;
+    vec3 lightColor;
+    bool lightEnabled;
+    vec3 viewPos;
+};
 
 void main()
 {
     FragPos = vec3(model * vec4(aPos, 1.0));
     Normal = mat3(transpose(inverse(model))) * aNormal;
     TexCoord = aTexCoord;
+    TexLayer = uLayer;
 
     gl_Position = projection * view * vec4(FragPos, 1.0);
 }
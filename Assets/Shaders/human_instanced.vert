@@ -0,0 +1,48 @@
+#version 330 core
+
+layout (location = 0) in vec3 aPos;
+layout (location = 1) in vec3 aNormal;
+layout (location = 2) in vec2 aTexCoord;
+
+// Per-instance attributes (divisor 1)
+layout (location = 3) in vec4 aPositionRotation;   // xyz = world position, w = yaw
+layout (location = 4) in float aLayer;
+
+out vec3 FragPos;
+out vec3 Normal;
+out vec2 TexCoord;
+flat out float TexLayer;
+
+uniform vec3 uPersonScale;
+
+// Per-frame data shared by all scene shaders (std140, binding 0)
+layout (std140) uniform FrameData
+{
+    mat4 view;
+    mat4 projection;
+    vec3 lightPos;
+    float lightIntensity;
+    vec3 lightColor;
+    bool lightEnabled;
+    vec3 viewPos;
+};
+
+void main()
+{
+    float s = sin(aPositionRotation.w);
+    float c = cos(aPositionRotation.w);
+
+    // Rotation about Y applied to the scaled local position
+    vec3 local = aPos * uPersonScale;
+    vec3 rotated = vec3(c * local.x + s * local.z, local.y, -s * local.x + c * local.z);
+    FragPos = rotated + aPositionRotation.xyz;
+
+    // Normal matrix of rotate * scale is rotate * inverse(scale)
+    vec3 n = aNormal / uPersonScale;
+    Normal = vec3(c * n.x + s * n.z, n.y, -s * n.x + c * n.z);
+
+    TexCoord = aTexCoord;
+    TexLayer = aLayer;
+
+    gl_Position = projection * view * vec4(FragPos, 1.0);
+}
@@ -8,14 +8,17 @@ in vec3 Normal;
 // Material properties
 uniform vec3 uBaseColor;
 
-// Light properties
-uniform vec3 lightPos;
-uniform vec3 lightColor;
-uniform float lightIntensity;
-uniform bool lightEnabled;
-
-// View position (camera)
-uniform vec3 viewPos;
+// Per-frame data shared by all scene shaders (std140, binding 0)
+layout (std140) uniform FrameData
+{
+    mat4 view;
+    mat4 projection;
+    vec3 lightPos;
+    float lightIntensity;
+    vec3 lightColor;
+    bool lightEnabled;
+    vec3 viewPos;
+};
 
 void main()
 {
@@ -0,0 +1,39 @@
+#version 330 core
+
+layout (location = 0) in vec3 aPos;
+layout (location = 1) in vec3 aNormal;
+
+// Per-instance attributes (divisor 1)
+layout (location = 2) in mat4 aModel;      // occupies locations 2-5
+layout (location = 6) in vec3 aBaseColor;
+
+out vec3 FragPos;
+out vec3 Normal;
+out vec3 BaseColor;
+
+// Per-frame data shared by all scene shaders (std140, binding 0)
+layout (std140) uniform FrameData
+{
+    mat4 view;
+    mat4 projection;
+    vec3 lightPos;
+    float lightIntensity;
+    vec3 lightColor;
+    bool lightEnabled;
+    vec3 viewPos;
+};
+
+void main()
+{
+    FragPos = vec3(aModel * vec4(aPos, 1.0));
+
+    // Instances are translate * rotate * scale, so the normal matrix is
+    // the model basis divided by the squared axis scales (no inverse needed)
+    mat3 basis = mat3(aModel);
+    vec3 scaleSq = vec3(dot(basis[0], basis[0]), dot(basis[1], basis[1]), dot(basis[2], basis[2]));
+    Normal = basis * (aNormal / scaleSq);
+
+    BaseColor = aBaseColor;
+
+    gl_Position = projection * view * vec4(FragPos, 1.0);
+}
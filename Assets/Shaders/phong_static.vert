@@ -0,0 +1,31 @@
+#version 330 core
+
+// Pre-transformed world-space geometry baked by Scene
+layout (location = 0) in vec3 aPos;
+layout (location = 1) in vec3 aNormal;
+layout (location = 2) in vec3 aColor;
+
+out vec3 FragPos;
+out vec3 Normal;
+out vec3 BaseColor;
+
+// Per-frame data shared by all scene shaders (std140, binding 0)
+layout (std140) uniform FrameData
+{
+    mat4 view;
+    mat4 projection;
+    vec3 lightPos;
+    float lightIntensity;
+    vec3 lightColor;
+    bool lightEnabled;
+    vec3 viewPos;
+};
+
+void main()
+{
+    FragPos = aPos;
+    Normal = aNormal;
+    BaseColor = aColor;
+
+    gl_Position = projection * view * vec4(FragPos, 1.0);
+}
@@ -0,0 +1,57 @@
+#version 330 core
+
+out vec4 FragColor;
+
+in vec3 FragPos;
+in vec3 Normal;
+in vec3 BaseColor;
+
+// Per-frame data shared by all scene shaders (std140, binding 0)
+layout (std140) uniform FrameData
+{
+    mat4 view;
+    mat4 projection;
+    vec3 lightPos;
+    float lightIntensity;
+    vec3 lightColor;
+    bool lightEnabled;
+    vec3 viewPos;
+};
+
+void main()
+{
+    if (!lightEnabled)
+    {
+        // If light is disabled, use very dark ambient
+        vec3 ambient = 0.1 * BaseColor;
+        FragColor = vec4(ambient, 1.0);
+        return;
+    }
+    
+    // Ambient - reduced to prevent over-brightness
+    float ambientStrength = 0.12;
+    vec3 ambient = ambientStrength * lightColor * BaseColor;
+    
+    // Diffuse
+    vec3 norm = normalize(Normal);
+    vec3 lightDir = normalize(lightPos - FragPos);
+    float diff = max(dot(norm, lightDir), 0.0);
+    vec3 diffuse = diff * lightColor * BaseColor;
+    
+    // Specular (Blinn-Phong) - reduced strength
+    float specularStrength = 0.2;
+    vec3 viewDir = normalize(viewPos - FragPos);
+    vec3 halfwayDir = normalize(lightDir + viewDir);
+    float spec = pow(max(dot(norm, halfwayDir), 0.0), 32.0);
+    vec3 specular = specularStrength * spec * lightColor;
+    
+    // Attenuation (distance-based) - adjusted for less falloff
+    float distance = length(lightPos - FragPos);
+    float attenuation = lightIntensity / (1.0 + 0.14 * distance + 0.05 * distance * distance);
+    
+    // Combine and clamp to prevent excessive brightness
+    vec3 result = (ambient + diffuse + specular) * attenuation;
+    result = clamp(result, 0.0, 1.0);  // Prevent over-saturation
+    
+    FragColor = vec4(result, 1.0);
+}
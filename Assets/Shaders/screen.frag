@@ -5,6 +5,9 @@ in vec2 TexCoord;
 out vec4 FragColor;
 
 uniform sampler2D uTex;
+uniform sampler2DArray uFilmFrames;
+uniform int uUseArray;
+uniform float uLayer;
 uniform int uForceSolid;
 uniform vec3 uSolidColor;
 uniform int uDebugUV;
@@ -25,6 +28,13 @@ void main()
         return;
     }
     
+    // Streaming playback samples the current layer of the frame ring
+    if (uUseArray == 1)
+    {
+        FragColor = texture(uFilmFrames, vec3(TexCoord, uLayer));
+        return;
+    }
+    
     // Normal texture sampling
     FragColor = texture(uTex, TexCoord);
 }
@@ -0,0 +1,14 @@
+﻿#pragma once
+
+#include "../Header/SeatLayout.h"
+
+inline SeatLayout makeBenchLayout(int rows, int cols, int sectionWidth = 25)
+{
+    SeatLayout layout;
+    layout.rows = rows;
+    layout.cols = cols;
+    layout.aisleColumns.clear();
+    for (int col = sectionWidth; col < cols; col += sectionWidth)
+        layout.aisleColumns.push_back(col);
+    return layout;
+}
@@ -0,0 +1,31 @@
+﻿#include "Benchmark.h"
+#include <iostream>
+#include <string>
+
+int main(int argc, char** argv)
+{
+    std::string assetRoot = "Assets";
+    std::string filter;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        if (arg == "--assets" && i + 1 < argc)
+            assetRoot = argv[++i];
+        else if (arg == "--filter" && i + 1 < argc)
+            filter = argv[++i];
+        else
+        {
+            std::cerr << "Usage: kostur_bench [--assets <dir>] [--filter <suite>]" << std::endl;
+            return 1;
+        }
+    }
+
+    int ran = Benchmark::runAll(assetRoot, filter);
+    if (ran == 0)
+    {
+        std::cerr << "[ERROR] No benchmark suites matched filter: " << filter << std::endl;
+        return 1;
+    }
+    return Benchmark::getFailureCount() > 0 ? 1 : 0;
+}
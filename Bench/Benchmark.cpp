@@ -0,0 +1,89 @@
+﻿#include "Benchmark.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+
+int Benchmark::s_failureCount = 0;
+
+std::vector<Benchmark::SuiteEntry>& Benchmark::suites()
+{
+    static std::vector<SuiteEntry> s_suites;
+    return s_suites;
+}
+
+void Benchmark::registerSuite(const std::string& name, Suite suite)
+{
+    SuiteEntry entry;
+    entry.name = name;
+    entry.suite = suite;
+    suites().push_back(entry);
+}
+
+int Benchmark::runAll(const std::string& assetRoot, const std::string& filter)
+{
+    int ran = 0;
+    for (const SuiteEntry& entry : suites())
+    {
+        if (!filter.empty() && entry.name.find(filter) == std::string::npos)
+            continue;
+
+        std::cerr << "[INFO] Running benchmark suite: " << entry.name << std::endl;
+        entry.suite(assetRoot);
+        ++ran;
+    }
+    return ran;
+}
+
+BenchmarkStats Benchmark::measure(const std::string& name, int iterations, const std::function<void()>& body)
+{
+    if (iterations < 1)
+        iterations = 1;
+
+    
+    body();
+
+    std::vector<double> samples;
+    samples.reserve(iterations);
+    for (int i = 0; i < iterations; ++i)
+    {
+        auto start = std::chrono::steady_clock::now();
+        body();
+        auto stop = std::chrono::steady_clock::now();
+        samples.push_back(std::chrono::duration<double, std::milli>(stop - start).count());
+    }
+
+    std::sort(samples.begin(), samples.end());
+
+    double total = 0.0;
+    for (double sample : samples)
+        total += sample;
+
+    BenchmarkStats stats;
+    stats.name = name;
+    stats.iterations = iterations;
+    stats.minMs = samples.front();
+    stats.medianMs = samples[samples.size() / 2];
+    stats.meanMs = total / samples.size();
+    stats.maxMs = samples.back();
+    return stats;
+}
+
+void Benchmark::report(const BenchmarkStats& stats, const std::string& extraJson)
+{
+    char buffer[256];
+    std::snprintf(buffer, sizeof(buffer),
+                  "{\"bench\":\"%s\",\"iterations\":%d,\"min_ms\":%.4f,\"median_ms\":%.4f,\"mean_ms\":%.4f,\"max_ms\":%.4f",
+                  stats.name.c_str(), stats.iterations, stats.minMs, stats.medianMs, stats.meanMs, stats.maxMs);
+
+    std::cout << buffer;
+    if (!extraJson.empty())
+        std::cout << "," << extraJson;
+    std::cout << "}" << std::endl;
+}
+
+void Benchmark::fail(const std::string& name, const std::string& reason)
+{
+    std::cerr << "[ERROR] Benchmark " << name << " failed: " << reason << std::endl;
+    ++s_failureCount;
+}
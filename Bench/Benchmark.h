@@ -0,0 +1,48 @@
+﻿#pragma once
+
+#include <functional>
+#include <string>
+#include <vector>
+
+struct BenchmarkStats
+{
+    std::string name;
+    int iterations;
+    double minMs;
+    double medianMs;
+    double meanMs;
+    double maxMs;
+};
+
+class Benchmark
+{
+public:
+    typedef std::function<void(const std::string& assetRoot)> Suite;
+
+    static void registerSuite(const std::string& name, Suite suite);
+    static int runAll(const std::string& assetRoot, const std::string& filter);
+
+    static BenchmarkStats measure(const std::string& name, int iterations, const std::function<void()>& body);
+    static void report(const BenchmarkStats& stats, const std::string& extraJson = std::string());
+
+    static void fail(const std::string& name, const std::string& reason);
+    static int getFailureCount() { return s_failureCount; }
+
+private:
+    struct SuiteEntry
+    {
+        std::string name;
+        Suite suite;
+    };
+
+    static std::vector<SuiteEntry>& suites();
+    static int s_failureCount;
+};
+
+struct BenchmarkRegistrar
+{
+    BenchmarkRegistrar(const std::string& name, Benchmark::Suite suite)
+    {
+        Benchmark::registerSuite(name, suite);
+    }
+};
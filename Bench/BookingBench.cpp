@@ -0,0 +1,191 @@
+﻿#include "Benchmark.h"
+#include "BenchLayouts.h"
+#include "../Header/BookingEngine.h"
+#include "../Header/SeatGrid.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <functional>
+#include <random>
+#include <thread>
+#include <vector>
+
+struct alignas(64) BookingCounters
+{
+    long long attempts;
+    long long bookings;
+    long long seatsSold;
+    long long conflicts;
+
+    BookingCounters() : attempts(0), bookings(0), seatsSold(0), conflicts(0) {}
+};
+
+struct KioskBudget
+{
+    std::atomic<int> seatsSold;
+    int targetSeats;
+    std::chrono::steady_clock::time_point deadline;
+};
+
+struct BookingRun
+{
+    double ms;
+    BookingCounters total;
+    int sold;
+    bool reachedTarget;
+};
+
+static const double SOLD_TARGET_FRACTION = 0.75;
+static const int RUN_LIMIT_MS = 2000;
+static const int DEADLINE_CHECK_INTERVAL = 64;
+static const int EXPIRY_SWEEP_INTERVAL = 256;
+
+static bool budgetLeft(const KioskBudget& budget, long long attempts)
+{
+    if (budget.seatsSold.load(std::memory_order_relaxed) >= budget.targetSeats)
+        return false;
+    return attempts % DEADLINE_CHECK_INTERVAL != 0 || std::chrono::steady_clock::now() < budget.deadline;
+}
+
+static void runKiosk(BookingEngine& engine, const SeatGrid& grid, bool adjacentOnly, bool sweepsExpiry, unsigned seed,
+                     KioskBudget& budget, BookingCounters& counters)
+{
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> groupDist(1, 6);
+    std::uniform_int_distribution<int> rowDist(0, grid.getRows() - 1);
+    std::uniform_int_distribution<int> outcomeDist(0, 99);
+    uint32_t session = engine.createSession();
+    int seats[BookingEngine::MAX_GROUP_SIZE];
+
+    
+    while (budgetLeft(budget, counters.attempts))
+    {
+        if (sweepsExpiry && counters.attempts % EXPIRY_SWEEP_INTERVAL == 0)
+            engine.expireHolds();
+        
+        int group = groupDist(rng);
+        ++counters.attempts;
+
+        bool held;
+        if (adjacentOnly)
+        {
+            held = engine.holdAdjacent(session, group, 50, seats);
+        }
+        else
+        {
+            
+            int row = rowDist(rng);
+            int start = std::uniform_int_distribution<int>(0, grid.getCols() - group)(rng);
+            for (int i = 0; i < group; ++i)
+                seats[i] = row * grid.getCols() + start + i;
+            held = engine.hold(session, seats, group, 50);
+        }
+
+        if (!held)
+        {
+            ++counters.conflicts;
+            continue;
+        }
+
+        
+        int outcome = outcomeDist(rng);
+        if (outcome < 85)
+        {
+            if (engine.confirm(session, seats, group))
+            {
+                ++counters.bookings;
+                counters.seatsSold += group;
+                budget.seatsSold.fetch_add(group, std::memory_order_relaxed);
+            }
+            else
+            {
+                ++counters.conflicts;
+            }
+        }
+        else if (outcome < 95)
+        {
+            engine.release(session, seats, group);
+        }
+    }
+}
+
+static void runBookingBenchmarks(const std::string&)
+{
+    SeatGrid grid;
+    grid.init(makeBenchLayout(100, 400));
+    const int seatCount = grid.getSeatCount();
+
+    std::vector<int> threadCounts = { 1, 2, 4 };
+    int hardware = (int)std::thread::hardware_concurrency();
+    if (hardware > 4)
+        threadCounts.push_back(hardware);
+
+    const bool modes[] = { false, true };
+    for (bool adjacentOnly : modes)
+    {
+        for (int threads : threadCounts)
+        {
+            BookingEngine engine;
+            std::vector<BookingRun> runs;
+
+            char name[64];
+            std::snprintf(name, sizeof(name), "booking/%s_threads_%d", adjacentOnly ? "adjacent" : "random", threads);
+            BenchmarkStats stats = Benchmark::measure(name, 3, [&]()
+            {
+                engine.init(grid);
+                KioskBudget budget;
+                budget.seatsSold.store(0, std::memory_order_relaxed);
+                budget.targetSeats = (int)(seatCount * SOLD_TARGET_FRACTION);
+                std::vector<BookingCounters> counters(threads);
+                std::vector<std::thread> kiosks;
+
+                auto start = std::chrono::steady_clock::now();
+                budget.deadline = start + std::chrono::milliseconds(RUN_LIMIT_MS);
+                for (int t = 0; t < threads; ++t)
+                {
+                    kiosks.emplace_back(runKiosk, std::ref(engine), std::cref(grid), adjacentOnly, t == 0, 1000u + t,
+                                        std::ref(budget), std::ref(counters[t]));
+                }
+
+                for (std::thread& kiosk : kiosks)
+                    kiosk.join();
+                auto stop = std::chrono::steady_clock::now();
+
+                BookingRun run;
+                run.ms = std::chrono::duration<double, std::milli>(stop - start).count();
+                for (const BookingCounters& c : counters)
+                {
+                    run.total.attempts += c.attempts;
+                    run.total.bookings += c.bookings;
+                    run.total.seatsSold += c.seatsSold;
+                    run.total.conflicts += c.conflicts;
+                }
+                run.reachedTarget = budget.seatsSold.load(std::memory_order_relaxed) >= budget.targetSeats;
+
+                run.sold = 0;
+                for (int s = 0; s < seatCount; ++s)
+                    run.sold += engine.getSeatState(s) == SeatState::Purchased ? 1 : 0;
+                runs.push_back(run);
+            });
+
+            
+            runs.erase(runs.begin());
+            std::sort(runs.begin(), runs.end(), [](const BookingRun& a, const BookingRun& b) { return a.ms < b.ms; });
+            const BookingRun& median = runs[runs.size() / 2];
+            const BookingCounters& total = median.total;
+
+            char extra[320];
+            std::snprintf(extra, sizeof(extra),
+                          "\"threads\":%d,\"run_ms\":%.2f,\"attempts\":%lld,\"bookings\":%lld,\"bookings_per_sec\":%.0f,"
+                          "\"conflict_rate\":%.3f,\"seats_sold\":%lld,\"stopped_by\":\"%s\",\"consistent\":%s",
+                          threads, median.ms, total.attempts, total.bookings, total.bookings * 1000.0 / median.ms,
+                          total.attempts > 0 ? (double)total.conflicts / total.attempts : 0.0, total.seatsSold,
+                          median.reachedTarget ? "sold_target" : "duration",
+                          total.seatsSold == median.sold ? "true" : "false");
+            Benchmark::report(stats, extra);
+        }
+    }
+}
+
+static BenchmarkRegistrar s_bookingBench("booking", runBookingBenchmarks);
@@ -0,0 +1,52 @@
+﻿#include "Benchmark.h"
+#include "BenchLayouts.h"
+#include "../Header/CameraCollider.h"
+#include "../Header/SeatGrid.h"
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+static void runCameraBenchmarks(const std::string&)
+{
+    const int sizes[][2] = { { 10, 50 }, { 50, 200 }, { 200, 400 } };
+    const int steps = 5000;
+    const float dt = 1.0f / 75.0f;
+    const float speed = 3.0f;
+
+    for (const auto& size : sizes)
+    {
+        
+        SeatGrid grid;
+        grid.init(makeBenchLayout(size[0], size[1]));
+        std::vector<AABB> colliders = grid.getPlatformBounds();
+        const std::vector<AABB>& seats = grid.getSeatBounds();
+        colliders.insert(colliders.end(), seats.begin(), seats.end());
+
+        CameraCollider collider;
+        collider.setColliders(colliders);
+
+        glm::vec3 finalPosition;
+        char name[96];
+        std::snprintf(name, sizeof(name), "camera/resolve_%d_colliders", (int)colliders.size());
+        BenchmarkStats stats = Benchmark::measure(name, 3, [&]()
+        {
+            
+            glm::vec3 position(grid.getSeatPosition(0) + glm::vec3(0.0f, 1.2f, -1.0f));
+            for (int s = 0; s < steps; ++s)
+            {
+                float heading = s * 0.002f;
+                glm::vec3 desired = position + glm::vec3(std::sin(heading), 0.0f, std::cos(heading)) * speed * dt;
+                position = collider.resolve(position, desired);
+            }
+            finalPosition = position;
+        });
+
+        char extra[192];
+        std::snprintf(extra, sizeof(extra), "\"colliders\":%d,\"steps\":%d,\"ns_per_step\":%.1f,\"checksum\":%.4f",
+                      (int)colliders.size(), steps, stats.medianMs * 1.0e6 / steps,
+                      finalPosition.x + finalPosition.y * 3.0f + finalPosition.z * 7.0f);
+        Benchmark::report(stats, extra);
+    }
+}
+
+static BenchmarkRegistrar s_cameraBench("camera", runCameraBenchmarks);
@@ -0,0 +1,235 @@
+﻿#include "Benchmark.h"
+#include "../Header/Crowd.h"
+#include "../Header/HallNavigation.h"
+#include "../Header/JobSystem.h"
+#include "../Header/SeatLayout.h"
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+struct BenchHall
+{
+    SeatLayout layout;
+    AABB floor;
+    glm::vec3 door;
+    std::vector<glm::vec3> seatPositions;
+    std::vector<AABB> seatBounds;
+};
+
+struct ShowStats
+{
+    int steps;
+    long long agentSteps;
+    int peakSeated;
+    int exited;
+    bool stalled;
+};
+
+static const float STEP_SECONDS = 1.0f / 60.0f;
+static const float STALL_SECONDS = 60.0f;
+
+static BenchHall createHall(int rows, int cols)
+{
+    BenchHall hall;
+    SeatLayout& layout = hall.layout;
+    layout.rows = rows;
+    layout.cols = cols;
+    layout.aisleColumns.clear();
+    for (int col = 20; col < layout.cols; col += 20)
+        layout.aisleColumns.push_back(col);
+    layout.origin = glm::vec3(0.0f, 0.5f, 0.0f);
+    
+    glm::vec3 halfExtents(0.5f, 0.55f, 0.5f);
+    for (int row = 0; row < layout.rows; ++row)
+    {
+        for (int col = 0; col < layout.cols; ++col)
+        {
+            glm::vec3 seat(layout.origin.x + (col - layout.cols / 2.0f + 0.5f) * layout.seatSpacingX +
+                           layout.aisleOffsetForColumn(col),
+                           layout.origin.y,
+                           layout.origin.z + row * layout.seatSpacingZ);
+            hall.seatPositions.push_back(seat);
+            hall.seatBounds.push_back(AABB(seat - halfExtents, seat + halfExtents));
+        }
+    }
+
+    float halfWidth = (layout.cols * layout.seatSpacingX + layout.totalAisleWidth()) * 0.5f + 3.0f;
+    float depth = layout.rows * layout.seatSpacingZ + 3.0f;
+    hall.floor = AABB(glm::vec3(-halfWidth, 0.4f, -12.0f), glm::vec3(halfWidth, 0.5f, depth));
+    hall.door = glm::vec3(-halfWidth + 1.0f, 0.5f, -11.0f);
+    return hall;
+}
+
+static void queueAudience(Crowd& crowd, const BenchHall& hall)
+{
+    int count = (int)hall.seatPositions.size();
+    crowd.clear();
+    crowd.reserve(count);
+    
+    for (int i = 0; i < count; ++i)
+    {
+        int seat = (int)((long long)i * 7919 % count);
+        crowd.queueSpawn(hall.door, hall.seatPositions[seat], glm::vec3(0.5f), i % 10);
+    }
+}
+
+static bool runUntil(Crowd& crowd, JobSystem* jobs, bool untilSeated, ShowStats& stats)
+{
+    int lastProgress = -1;
+    int idleSteps = 0;
+    const int stallSteps = (int)(STALL_SECONDS / STEP_SECONDS);
+
+    while (untilSeated ? !crowd.allSeated() : !crowd.allExited())
+    {
+        crowd.update(STEP_SECONDS, jobs);
+        ++stats.steps;
+        stats.agentSteps += crowd.size() - crowd.getSeatedCount() - crowd.getExitedCount();
+        if (crowd.getSeatedCount() > stats.peakSeated)
+            stats.peakSeated = crowd.getSeatedCount();
+        
+        int progress = crowd.size() + crowd.getSeatedCount() + 2 * crowd.getExitedCount();
+        idleSteps = progress == lastProgress ? idleSteps + 1 : 0;
+        lastProgress = progress;
+        if (idleSteps > stallSteps)
+        {
+            stats.stalled = true;
+            return false;
+        }
+    }
+    return true;
+}
+
+static ShowStats emptyStats()
+{
+    ShowStats stats;
+    stats.steps = 0;
+    stats.agentSteps = 0;
+    stats.peakSeated = 0;
+    stats.exited = 0;
+    stats.stalled = false;
+    return stats;
+}
+
+static void reportShow(const BenchmarkStats& stats, const ShowStats& show, int agents, int workers)
+{
+    char extra[320];
+    std::snprintf(extra, sizeof(extra),
+                  "\"agents\":%d,\"workers\":%d,\"steps\":%d,\"simulated_s\":%.1f,\"agent_steps\":%lld,"
+                  "\"ns_per_agent_step\":%.2f,\"seated\":%d,\"exited\":%d,\"stalled\":%s",
+                  agents, workers, show.steps, show.steps * STEP_SECONDS, show.agentSteps,
+                  show.agentSteps > 0 ? stats.medianMs * 1.0e6 / (double)show.agentSteps : 0.0,
+                  show.peakSeated, show.exited, show.stalled ? "true" : "false");
+    Benchmark::report(stats, extra);
+
+    if (show.stalled || show.exited != agents)
+    {
+        Benchmark::fail(stats.name, "crowd stopped making progress (" + std::to_string(show.peakSeated) + " seated, " +
+                                    std::to_string(show.exited) + "/" + std::to_string(agents) + " exited)");
+    }
+}
+
+static void runCrowdBenchmarks(const std::string&)
+{
+    std::vector<AABB> surfaces;
+    
+    const int navSizes[][2] = { { 10, 100 }, { 30, 200 }, { 60, 400 } };
+    for (const auto& size : navSizes)
+    {
+        BenchHall hall = createHall(size[0], size[1]);
+        HallNavigation navigation;
+
+        char name[64];
+        std::snprintf(name, sizeof(name), "crowd_nav/build_%dx%d", size[0], size[1]);
+        BenchmarkStats stats = Benchmark::measure(name, 3, [&]()
+        {
+            navigation.build(hall.floor, hall.layout, hall.seatPositions, hall.seatBounds, surfaces, hall.door);
+        });
+
+        char extra[192];
+        std::snprintf(extra, sizeof(extra), "\"cells\":%d,\"row_accesses\":%d,\"entry_path_cells\":%d,\"valid\":%s",
+                      navigation.getGrid().getCellCount(), navigation.getAccessCount(),
+                      navigation.getEntryPathCellCount(), navigation.isValid() ? "true" : "false");
+        Benchmark::report(stats, extra);
+    }
+
+    std::vector<int> workerCounts = { 0, 1, 3 };
+    int hardware = (int)std::thread::hardware_concurrency();
+    if (hardware - 1 > 3)
+        workerCounts.push_back(hardware - 1);
+
+    JobSystem showJobs;
+    showJobs.init(workerCounts.back());
+    
+    const int showSizes[][2] = { { 5, 40 }, { 10, 100 } };
+    for (const auto& size : showSizes)
+    {
+        BenchHall hall = createHall(size[0], size[1]);
+        HallNavigation navigation;
+        navigation.build(hall.floor, hall.layout, hall.seatPositions, hall.seatBounds, surfaces, hall.door);
+
+        Crowd crowd;
+        crowd.setNavigation(&navigation);
+        int agents = (int)hall.seatPositions.size();
+        ShowStats show = emptyStats();
+
+        char name[64];
+        std::snprintf(name, sizeof(name), "crowd_show/agents_%d", agents);
+        BenchmarkStats stats = Benchmark::measure(name, agents > 500 ? 1 : 3, [&]()
+        {
+            show = emptyStats();
+            queueAudience(crowd, hall);
+            if (runUntil(crowd, &showJobs, true, show))
+            {
+                crowd.startExiting();
+                runUntil(crowd, &showJobs, false, show);
+            }
+            show.exited = crowd.getExitedCount();
+        });
+
+        reportShow(stats, show, agents, workerCounts.back());
+    }
+    
+    BenchHall exitHall = createHall(20, 60);
+    HallNavigation exitNavigation;
+    exitNavigation.build(exitHall.floor, exitHall.layout, exitHall.seatPositions, exitHall.seatBounds, surfaces,
+                         exitHall.door);
+
+    Crowd seatedCrowd;
+    seatedCrowd.setNavigation(&exitNavigation);
+    queueAudience(seatedCrowd, exitHall);
+    ShowStats entry = emptyStats();
+    int exitAgents = (int)exitHall.seatPositions.size();
+    if (!runUntil(seatedCrowd, &showJobs, true, entry))
+    {
+        Benchmark::fail("crowd_exit", "audience never finished seating (" + std::to_string(entry.peakSeated) + "/" +
+                                      std::to_string(exitAgents) + " seated)");
+        return;
+    }
+
+    for (size_t w = 0; w < workerCounts.size(); ++w)
+    {
+        JobSystem jobs;
+        if (w > 0)
+            jobs.init(workerCounts[w]);
+        JobSystem* jobPtr = w > 0 ? &jobs : nullptr;
+
+        Crowd crowd;
+        ShowStats show = emptyStats();
+
+        char name[64];
+        std::snprintf(name, sizeof(name), "crowd_exit/workers_%d", workerCounts[w]);
+        BenchmarkStats stats = Benchmark::measure(name, 1, [&]()
+        {
+            crowd = seatedCrowd;
+            show = emptyStats();
+            show.peakSeated = crowd.getSeatedCount();
+            crowd.startExiting();
+            runUntil(crowd, jobPtr, false, show);
+            show.exited = crowd.getExitedCount();
+        });
+
+        reportShow(stats, show, exitAgents, workerCounts[w]);
+    }
+}
+
+static BenchmarkRegistrar s_crowdBench("crowd", runCrowdBenchmarks);
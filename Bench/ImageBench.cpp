@@ -0,0 +1,82 @@
+﻿#define STB_IMAGE_IMPLEMENTATION
+#include "Benchmark.h"
+#include "../Header/ImageDecodePool.h"
+#include "../Header/stb_image.h"
+#include <cstdio>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+static std::vector<std::string> findFilmFrames(const std::string& assetRoot, int maxFrames)
+{
+    std::vector<std::string> paths;
+    for (int i = 1; i <= maxFrames; ++i)
+    {
+        std::ostringstream oss;
+        oss << assetRoot << "/Textures/" << std::setfill('0') << std::setw(3) << i << ".png";
+
+        FILE* probe = std::fopen(oss.str().c_str(), "rb");
+        if (!probe)
+            break;
+        std::fclose(probe);
+        paths.push_back(oss.str());
+    }
+    return paths;
+}
+
+static void runImageBenchmarks(const std::string& assetRoot)
+{
+    std::vector<std::string> frames = findFilmFrames(assetRoot, 100);
+    if (frames.empty())
+    {
+        std::cerr << "[WARNING] Benchmark film frames not found under: " << assetRoot << "/Textures" << std::endl;
+        return;
+    }
+
+    
+    const int serialCount = frames.size() < 10 ? (int)frames.size() : 10;
+    long long pixelBytes = 0;
+    BenchmarkStats serialStats = Benchmark::measure("png_decode/serial", 3, [&]()
+    {
+        pixelBytes = 0;
+        for (int i = 0; i < serialCount; ++i)
+        {
+            int width, height, channels;
+            unsigned char* pixels = stbi_load(frames[i].c_str(), &width, &height, &channels, 4);
+            if (pixels)
+                pixelBytes += (long long)width * height * 4;
+            stbi_image_free(pixels);
+        }
+    });
+
+    char extra[160];
+    std::snprintf(extra, sizeof(extra), "\"images\":%d,\"ms_per_image\":%.3f,\"megapixels\":%.2f",
+                  serialCount, serialStats.medianMs / serialCount, pixelBytes / 4.0e6);
+    Benchmark::report(serialStats, extra);
+
+    
+    ImageDecodePool pool;
+    pool.init();
+    int decoded = 0;
+    BenchmarkStats poolStats = Benchmark::measure("png_decode/pool", 3, [&]()
+    {
+        for (int i = 0; i < (int)frames.size(); ++i)
+            pool.request(i, frames[i], true, 4);
+
+        decoded = 0;
+        DecodedImage image;
+        while (decoded < (int)frames.size() && pool.waitCompleted(image))
+        {
+            ImageDecodePool::release(image);
+            ++decoded;
+        }
+    });
+
+    std::snprintf(extra, sizeof(extra), "\"images\":%d,\"workers\":%d,\"ms_per_image\":%.3f",
+                  decoded, pool.getWorkerCount(), poolStats.medianMs / frames.size());
+    Benchmark::report(poolStats, extra);
+    pool.shutdown();
+}
+
+static BenchmarkRegistrar s_imageBench("png_decode", runImageBenchmarks);
@@ -0,0 +1,41 @@
+﻿#include "Benchmark.h"
+#include "../Header/ObjParser.h"
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+
+static void runObjParserBenchmarks(const std::string& assetRoot)
+{
+    const char* models[] = { "human1.obj", "human2.obj", "seat.obj" };
+    const bool withTexCoords[] = { true, true, false };
+
+    for (int m = 0; m < 3; ++m)
+    {
+        std::string path = assetRoot + "/Models/" + models[m];
+
+        std::ifstream file(path, std::ios::binary);
+        if (!file.is_open())
+        {
+            std::cerr << "[WARNING] Benchmark model not found: " << path << std::endl;
+            continue;
+        }
+        std::string text((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+        ObjMeshData mesh;
+        BenchmarkStats stats = Benchmark::measure(std::string("obj_parse/") + models[m], 20, [&]()
+        {
+            ObjParser::parse(text.data(), text.size(), withTexCoords[m], mesh);
+        });
+
+        double megabytes = text.size() / (1024.0 * 1024.0);
+        char extra[192];
+        std::snprintf(extra, sizeof(extra),
+                      "\"bytes\":%zu,\"mb_per_s\":%.1f,\"vertices\":%d,\"indices\":%d",
+                      text.size(), megabytes / (stats.medianMs / 1000.0),
+                      mesh.getVertexCount(), mesh.getIndexCount());
+        Benchmark::report(stats, extra);
+    }
+}
+
+static BenchmarkRegistrar s_objParserBench("obj_parser", runObjParserBenchmarks);
@@ -0,0 +1,86 @@
+﻿#include "Benchmark.h"
+#include "../Header/RayBoxKernel.h"
+#include <cstdio>
+#include <random>
+#include <vector>
+
+static void runRayBoxKernelBenchmarks(const std::string&)
+{
+    const int boxCount = 100000;
+    const int rayCount = 64;
+
+    std::mt19937 rng(42u);
+    std::uniform_real_distribution<float> coord(-50.0f, 50.0f);
+    std::uniform_real_distribution<float> extent(0.1f, 1.0f);
+
+    std::vector<AABB> boxList;
+    boxList.reserve(boxCount);
+    for (int i = 0; i < boxCount; ++i)
+    {
+        glm::vec3 center(coord(rng), coord(rng) * 0.1f, coord(rng));
+        glm::vec3 half(extent(rng), extent(rng), extent(rng));
+        boxList.push_back(AABB(center - half, center + half));
+    }
+
+    AABBSoA boxes;
+    boxes.assign(boxList);
+
+    std::vector<Ray> rays;
+    for (int r = 0; r < rayCount; ++r)
+        rays.push_back(Ray(glm::vec3(-60.0f, coord(rng) * 0.1f, coord(rng)), glm::vec3(1.0f, coord(rng) * 0.001f, coord(rng) * 0.01f)));
+
+    
+    const SimdLevel levels[] = { SimdLevel::Scalar, SimdLevel::SSE, SimdLevel::AVX2 };
+    for (SimdLevel level : levels)
+    {
+        if (level > RayBoxKernel::getSupportedLevel())
+            continue;
+
+        long long checksum = 0;
+        char name[64];
+        std::snprintf(name, sizeof(name), "ray_box/nearest_%s", RayBoxKernel::levelName(level));
+        BenchmarkStats stats = Benchmark::measure(name, 10, [&]()
+        {
+            checksum = 0;
+            for (const Ray& ray : rays)
+            {
+                float tNear;
+                checksum += RayBoxKernel::intersectNearest(level, ray, boxes, 0, boxes.size(), 1.0e30f, tNear);
+            }
+        });
+
+        char extra[128];
+        std::snprintf(extra, sizeof(extra), "\"boxes\":%d,\"rays\":%d,\"ns_per_box\":%.3f,\"checksum\":%lld",
+                      boxCount, rayCount, stats.medianMs * 1.0e6 / ((double)boxCount * rayCount), checksum);
+        Benchmark::report(stats, extra);
+    }
+
+    
+    for (SimdLevel level : levels)
+    {
+        if (level > RayBoxKernel::getSupportedLevel())
+            continue;
+
+        const int leafSize = 4;
+        long long checksum = 0;
+        char name[64];
+        std::snprintf(name, sizeof(name), "ray_box/leaf4_%s", RayBoxKernel::levelName(level));
+        BenchmarkStats stats = Benchmark::measure(name, 10, [&]()
+        {
+            checksum = 0;
+            for (int first = 0; first + leafSize <= boxes.size(); first += leafSize + 1)
+            {
+                float tNear;
+                checksum += RayBoxKernel::intersectNearest(level, rays[first & (rayCount - 1)], boxes, first, leafSize, 1.0e30f, tNear);
+            }
+        });
+
+        int calls = boxes.size() / (leafSize + 1);
+        char extra[128];
+        std::snprintf(extra, sizeof(extra), "\"calls\":%d,\"ns_per_call\":%.3f,\"checksum\":%lld",
+                      calls, stats.medianMs * 1.0e6 / calls, checksum);
+        Benchmark::report(stats, extra);
+    }
+}
+
+static BenchmarkRegistrar s_rayBoxKernelBench("ray_box", runRayBoxKernelBenchmarks);
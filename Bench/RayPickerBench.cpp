@@ -0,0 +1,160 @@
+﻿#include "Benchmark.h"
+#include "BenchLayouts.h"
+#include "../Header/AABB.h"
+#include "../Header/RayPicker.h"
+#include "../Header/SeatGrid.h"
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+static std::vector<Ray> createSeatRays(const SeatGrid& grid, int count, unsigned seed)
+{
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> seat(0, grid.getSeatCount() - 1);
+    std::uniform_real_distribution<float> jitter(-0.4f, 0.4f);
+
+    
+    glm::vec3 eye(0.0f, 4.0f, -8.0f);
+    std::vector<Ray> rays;
+    rays.reserve(count);
+    for (int i = 0; i < count; ++i)
+    {
+        glm::vec3 target = grid.getSeatPosition(seat(rng)) + glm::vec3(jitter(rng), jitter(rng), jitter(rng));
+        rays.push_back(Ray(eye, target - eye));
+    }
+    return rays;
+}
+
+static void runRayPickerBenchmarks(const std::string&)
+{
+    RayPicker picker;
+
+    
+    {
+        const int boxCount = 100000;
+        std::mt19937 rng(42u);
+        std::uniform_real_distribution<float> coord(-50.0f, 50.0f);
+        std::uniform_real_distribution<float> extent(0.1f, 1.0f);
+
+        std::vector<AABB> boxes;
+        boxes.reserve(boxCount);
+        for (int i = 0; i < boxCount; ++i)
+        {
+            glm::vec3 center(coord(rng), coord(rng) * 0.1f, coord(rng));
+            glm::vec3 half(extent(rng), extent(rng), extent(rng));
+            boxes.push_back(AABB(center - half, center + half));
+        }
+
+        Ray ray(glm::vec3(-60.0f, 0.5f, -60.0f), glm::vec3(1.0f, 0.01f, 0.97f));
+        int hits = 0;
+        BenchmarkStats stats = Benchmark::measure("ray_picker/intersect_aabb", 20, [&]()
+        {
+            hits = 0;
+            float tNear;
+            for (const AABB& box : boxes)
+                hits += picker.intersectAABB(ray, box, tNear) ? 1 : 0;
+        });
+
+        char extra[128];
+        std::snprintf(extra, sizeof(extra), "\"boxes\":%d,\"ns_per_test\":%.3f,\"hits\":%d",
+                      boxCount, stats.medianMs * 1.0e6 / boxCount, hits);
+        Benchmark::report(stats, extra);
+    }
+
+    
+    const int sizes[][2] = { { 10, 50 }, { 50, 200 }, { 100, 400 } };
+    for (const auto& size : sizes)
+    {
+        SeatGrid grid;
+        grid.init(makeBenchLayout(size[0], size[1]));
+
+        const int rayCount = 256;
+        std::vector<Ray> rays = createSeatRays(grid, rayCount, 7u);
+        long long checksum = 0;
+
+        char name[96];
+        std::snprintf(name, sizeof(name), "ray_picker/pick_seat_%dx%d", size[0], size[1]);
+        BenchmarkStats stats = Benchmark::measure(name, 5, [&]()
+        {
+            checksum = 0;
+            for (const Ray& ray : rays)
+                checksum += picker.pickSeat(ray, grid);
+        });
+
+        char extra[160];
+        std::snprintf(extra, sizeof(extra), "\"seats\":%d,\"rays\":%d,\"us_per_pick\":%.3f,\"checksum\":%lld",
+                      grid.getSeatCount(), rayCount, stats.medianMs * 1000.0 / rayCount, checksum);
+        Benchmark::report(stats, extra);
+
+        
+        RayPicker scenePicker;
+        std::snprintf(name, sizeof(name), "ray_picker/bvh_build_%dx%d", size[0], size[1]);
+        BenchmarkStats buildStats = Benchmark::measure(name, 3, [&]()
+        {
+            scenePicker.buildScene(grid, grid.getPlatformBounds());
+        });
+
+        std::snprintf(extra, sizeof(extra), "\"seats\":%d,\"nodes\":%d",
+                      grid.getSeatCount(), scenePicker.getStaticBVH().getNodeCount());
+        Benchmark::report(buildStats, extra);
+
+        
+        const int bvhRayCount = 65536;
+        std::vector<Ray> bvhRays = createSeatRays(grid, bvhRayCount, 7u);
+        long long bvhChecksum = 0;
+        int mismatches = 0;
+        std::snprintf(name, sizeof(name), "ray_picker/bvh_pick_%dx%d", size[0], size[1]);
+        BenchmarkStats bvhStats = Benchmark::measure(name, 5, [&]()
+        {
+            bvhChecksum = 0;
+            for (const Ray& ray : bvhRays)
+                bvhChecksum += scenePicker.pickSeatOccluded(ray);
+        });
+
+        for (int r = 0; r < rayCount; ++r)
+        {
+            PickResult result = scenePicker.pick(bvhRays[r]);
+            int bruteSeat = picker.pickSeat(bvhRays[r], grid);
+            if (result.target == PickTarget::Seat && result.index != bruteSeat)
+                ++mismatches;
+        }
+
+        std::snprintf(extra, sizeof(extra), "\"seats\":%d,\"rays\":%d,\"ns_per_pick\":%.1f,\"mismatches\":%d,\"checksum\":%lld",
+                      grid.getSeatCount(), bvhRayCount, bvhStats.medianMs * 1.0e6 / bvhRayCount, mismatches, bvhChecksum);
+        Benchmark::report(bvhStats, extra);
+    }
+
+    
+    {
+        const int peopleCount = 24000;
+        std::mt19937 rng(99u);
+        std::uniform_real_distribution<float> coord(-40.0f, 40.0f);
+        std::vector<glm::vec3> positions(peopleCount);
+        for (glm::vec3& p : positions)
+            p = glm::vec3(coord(rng), 0.6f, coord(rng));
+
+        std::vector<AABB> bounds(peopleCount);
+        glm::vec3 halfExtents(0.55f, 0.6f, 0.55f);
+        RayPicker scenePicker;
+        int frame = 0;
+        BenchmarkStats stats = Benchmark::measure("ray_picker/people_refit_24000", 60, [&]()
+        {
+            
+            ++frame;
+            for (int i = 0; i < peopleCount; ++i)
+            {
+                glm::vec3 p = positions[i] + glm::vec3(std::sin(frame * 0.01f + i), 0.0f, std::cos(frame * 0.01f + i)) * 0.05f;
+                bounds[i] = AABB(p - halfExtents, p + halfExtents);
+            }
+            scenePicker.updatePeople(bounds);
+        });
+
+        char extra[128];
+        std::snprintf(extra, sizeof(extra), "\"people\":%d,\"nodes\":%d,\"growth\":%.3f",
+                      peopleCount, scenePicker.getPeopleBVH().getNodeCount(), scenePicker.getPeopleBVH().getRefitGrowth());
+        Benchmark::report(stats, extra);
+    }
+}
+
+static BenchmarkRegistrar s_rayPickerBench("ray_picker", runRayPickerBenchmarks);
@@ -0,0 +1,75 @@
+﻿#include "Benchmark.h"
+#include "BenchLayouts.h"
+#include "../Header/SeatGrid.h"
+#include <cstdio>
+#include <random>
+
+static void runSeatGridBenchmarks(const std::string&)
+{
+    const int sizes[][2] = { { 10, 50 }, { 50, 200 }, { 100, 400 } };
+
+    for (const auto& size : sizes)
+    {
+        SeatGrid grid;
+        grid.init(makeBenchLayout(size[0], size[1]));
+        int seats = grid.getSeatCount();
+
+        
+        int purchases = 0;
+        char name[96];
+        std::snprintf(name, sizeof(name), "seat_grid/purchase_fill_%dx%d", size[0], size[1]);
+        BenchmarkStats fillStats = Benchmark::measure(name, 3, [&]()
+        {
+            grid.resetAllSeats();
+            purchases = 0;
+            for (int groupSize = 9; groupSize >= 1; --groupSize)
+            {
+                while (grid.purchaseAdjacent(groupSize))
+                    ++purchases;
+            }
+        });
+
+        char extra[160];
+        std::snprintf(extra, sizeof(extra), "\"seats\":%d,\"purchases\":%d,\"us_per_purchase\":%.3f,\"occupied\":%d",
+                      seats, purchases, fillStats.medianMs * 1000.0 / purchases, grid.countOccupiedSeats());
+        Benchmark::report(fillStats, extra);
+
+        
+        std::mt19937 rng(1234u);
+        grid.resetAllSeats();
+        for (int i = 0; i < seats; ++i)
+        {
+            if (rng() % 8 != 0)
+                grid.setSeatState(i, SeatState::Purchased);
+        }
+
+        const int queries = 200;
+        int found = 0;
+        std::snprintf(name, sizeof(name), "seat_grid/purchase_miss_%dx%d", size[0], size[1]);
+        BenchmarkStats missStats = Benchmark::measure(name, 5, [&]()
+        {
+            found = 0;
+            for (int q = 0; q < queries; ++q)
+                found += grid.purchaseAdjacent(9) ? 1 : 0;
+        });
+
+        std::snprintf(extra, sizeof(extra), "\"seats\":%d,\"queries\":%d,\"us_per_query\":%.3f,\"found\":%d",
+                      seats, queries, missStats.medianMs * 1000.0 / queries, found);
+        Benchmark::report(missStats, extra);
+
+        
+        int occupied = 0;
+        std::snprintf(name, sizeof(name), "seat_grid/count_occupied_%dx%d", size[0], size[1]);
+        BenchmarkStats countStats = Benchmark::measure(name, 5, [&]()
+        {
+            for (int q = 0; q < queries; ++q)
+                occupied = grid.countOccupiedSeats();
+        });
+
+        std::snprintf(extra, sizeof(extra), "\"seats\":%d,\"queries\":%d,\"us_per_query\":%.3f,\"occupied\":%d",
+                      seats, queries, countStats.medianMs * 1000.0 / queries, occupied);
+        Benchmark::report(countStats, extra);
+    }
+}
+
+static BenchmarkRegistrar s_seatGridBench("seat_grid", runSeatGridBenchmarks);
@@ -0,0 +1,59 @@
+﻿#pragma once
+
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+#if defined(_MSC_VER)
+#include <malloc.h>
+#endif
+
+template <typename T, std::size_t Alignment>
+class AlignedAllocator
+{
+public:
+    typedef T value_type;
+
+    template <typename U>
+    struct rebind
+    {
+        typedef AlignedAllocator<U, Alignment> other;
+    };
+
+    AlignedAllocator() {}
+
+    template <typename U>
+    AlignedAllocator(const AlignedAllocator<U, Alignment>&) {}
+
+    T* allocate(std::size_t count)
+    {
+        if (count == 0)
+            return nullptr;
+
+#if defined(_MSC_VER)
+        void* memory = _aligned_malloc(count * sizeof(T), Alignment);
+#else
+        void* memory = nullptr;
+        if (posix_memalign(&memory, Alignment, count * sizeof(T)) != 0)
+            memory = nullptr;
+#endif
+        if (!memory)
+            throw std::bad_alloc();
+        return static_cast<T*>(memory);
+    }
+
+    void deallocate(T* pointer, std::size_t)
+    {
+#if defined(_MSC_VER)
+        _aligned_free(pointer);
+#else
+        std::free(pointer);
+#endif
+    }
+
+    template <typename U>
+    bool operator==(const AlignedAllocator<U, Alignment>&) const { return true; }
+
+    template <typename U>
+    bool operator!=(const AlignedAllocator<U, Alignment>&) const { return false; }
+};
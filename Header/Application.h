@@ -1,7 +1,10 @@
 ﻿#pragma once
 
+#include "AABB.h"
 #include "AppState.h"
+#include <cstdint>
 #include <memory>
+#include <vector>
 
 class Window;
 class FrameLimiter;
@@ -12,12 +15,33 @@ class HumanMesh;
 class Shader;
 class Scene;
 class SeatGrid;
+class SeatRenderer;
+class BookingEngine;
 class RayPicker;
 class Crosshair;
 class PeopleManager;
 class Screen;
 class Door;
 class HUD;
+class FrameUniforms;
+class JobSystem;
+class HallNavigation;
+class GpuProfiler;
+
+struct HeadlessOptions
+{
+    int cycles;
+    int seatsPerCycle;
+    float timeStep;
+    double maxSimulatedSeconds;
+    
+    HeadlessOptions()
+        : cycles(1)
+        , seatsPerCycle(20)
+        , timeStep(1.0f / 60.0f)
+        , maxSimulatedSeconds(3600.0)
+    {}
+};
 
 class Application
 {
@@ -25,18 +49,26 @@ public:
     Application();
     ~Application();
 
-    bool init();
+#ifndef KOSTUR_HEADLESS_ONLY
+    bool init(bool vsync = false);
     void run();
+#endif
     void shutdown();
+    
+    bool initHeadless(const HeadlessOptions& options);
+    int runHeadless();
 
 private:
 
+#ifndef KOSTUR_HEADLESS_ONLY
 void handleSeatPicking();
 void handlePurchaseKeys();
 void handleEnterKey();
 void handleRenderToggles();
+#endif
     
     
+    void simulationStep(float deltaTime);
     void updateStateMachine(float deltaTime);
     void enterState(AppState newState);
     int countOccupiedSeats() const;
@@ -52,15 +84,26 @@ void handleRenderToggles();
     
     void setLightingForState(AppState state);
     
+    
+    void createSimulation(const std::vector<AABB>& walkableBounds);
+    void bookHeadlessSeats();
+    
     bool m_running;
     AppState m_currentState;
     float m_stateTimer;
     float m_debugPrintTimer;
+    float m_holdExpiryTimer;
     
     
     bool m_depthTestEnabled;
     bool m_cullingEnabled;
     
+    HeadlessOptions m_headlessOptions;
+    double m_simulationAccumulator;
+    glm::vec3 m_doorEntryPosition;
+    
+#ifndef KOSTUR_HEADLESS_ONLY
+    std::vector<AABB> m_pickBounds;
     std::unique_ptr<Window> m_window;
     std::unique_ptr<FrameLimiter> m_frameLimiter;
     std::unique_ptr<Camera> m_camera;
@@ -70,12 +113,30 @@ void handleRenderToggles();
     std::unique_ptr<Shader> m_basicShader;
     std::unique_ptr<Shader> m_phongShader;
     std::unique_ptr<Shader> m_humanShader;
-    std::unique_ptr<Scene> m_scene;
-    std::unique_ptr<SeatGrid> m_seatGrid;
+    std::unique_ptr<Shader> m_crowdShader;
+    std::unique_ptr<Shader> m_instancedShader;
+    std::unique_ptr<Shader> m_staticShader;
+    std::unique_ptr<FrameUniforms> m_frameUniforms;
+    std::unique_ptr<SeatRenderer> m_seatRenderer;
     std::unique_ptr<RayPicker> m_rayPicker;
     std::unique_ptr<Crosshair> m_crosshair;
+    std::unique_ptr<HUD> m_hud;
+    std::unique_ptr<GpuProfiler> m_gpuProfiler;
+#endif
+    
+    std::unique_ptr<Scene> m_scene;
+    std::unique_ptr<SeatGrid> m_seatGrid;
+    std::unique_ptr<BookingEngine> m_bookingEngine;
+    uint32_t m_pickerSession;
     std::unique_ptr<PeopleManager> m_peopleManager;
     std::unique_ptr<Screen> m_screen;
     std::unique_ptr<Door> m_door;
-    std::unique_ptr<HUD> m_hud;
+    std::unique_ptr<JobSystem> m_jobSystem;
+    std::unique_ptr<HallNavigation> m_navigation;
+    
+    static constexpr int HUMAN_TEXTURE_LAYER_SIZE = 512;
+    static constexpr float SIMULATION_STEP = 1.0f / 60.0f;
+    static constexpr int MAX_SIMULATION_STEPS = 5;
+    static constexpr float HOLD_EXPIRY_INTERVAL = 1.0f;
+    static constexpr int PROFILE_CAPTURE_FRAMES = 300;
 };
@@ -0,0 +1,63 @@
+﻿#pragma once
+
+#include "AABB.h"
+#include "Ray.h"
+#include "RayBoxKernel.h"
+#include <glm/glm.hpp>
+#include <limits>
+#include <vector>
+
+struct BVHNode
+{
+    AABB bounds;
+    int leftFirst;
+    int count;
+
+    bool isLeaf() const { return count > 0; }
+};
+
+struct BVHHit
+{
+    int primitive;
+    float distance;
+
+    BVHHit() : primitive(-1), distance(std::numeric_limits<float>::max()) {}
+};
+
+class BVH
+{
+public:
+    BVH();
+
+    void build(const std::vector<AABB>& primitives);
+    void refit(const std::vector<AABB>& primitives);
+    void clear();
+
+    bool intersect(const Ray& ray, BVHHit& hit) const;
+
+    bool empty() const { return m_nodes.empty(); }
+    int getNodeCount() const { return (int)m_nodes.size(); }
+    int getPrimitiveCount() const { return (int)m_indices.size(); }
+    float getRefitGrowth() const;
+
+    const std::vector<BVHNode>& getNodes() const { return m_nodes; }
+    const AABBSoA& getLeafBoxes() const { return m_leafBoxes; }
+    const std::vector<int>& getIndices() const { return m_indices; }
+
+private:
+    static constexpr int SAH_BINS = 16;
+    static constexpr int MAX_LEAF_SIZE = 4;
+    static constexpr int MAX_DEPTH = 64;
+    static constexpr float TRAVERSAL_COST = 1.0f;
+
+    std::vector<BVHNode> m_nodes;
+    std::vector<int> m_indices;
+    AABBSoA m_leafBoxes;
+    const std::vector<AABB>* m_buildPrimitives;
+    std::vector<glm::vec3> m_centroids;
+    float m_builtRootArea;
+
+    void subdivide(int nodeIndex, int depth);
+    void updateNodeBounds(int nodeIndex);
+    bool findSplit(const BVHNode& node, int& axis, int& splitBin, float& centroidMin, float& binScale) const;
+};
@@ -0,0 +1,29 @@
+﻿#pragma once
+
+#include <cstdint>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+inline int highestBit(uint64_t value)
+{
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanReverse64(&index, value);
+    return (int)index;
+#else
+    return 63 - __builtin_clzll(value);
+#endif
+}
+
+inline int lowestBit(uint64_t value)
+{
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward64(&index, value);
+    return (int)index;
+#else
+    return __builtin_ctzll(value);
+#endif
+}
@@ -0,0 +1,95 @@
+﻿#pragma once
+
+#include "Seat.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+
+class SeatGrid;
+
+class BookingEngine
+{
+public:
+    BookingEngine();
+    ~BookingEngine();
+    
+    BookingEngine(const BookingEngine&) = delete;
+    BookingEngine& operator=(const BookingEngine&) = delete;
+    
+    void init(const SeatGrid& grid);
+    void reset();
+    
+    
+    uint32_t createSession();
+    
+    
+    
+    bool hold(uint32_t session, const int* seats, int count, int durationMs);
+    bool confirm(uint32_t session, const int* seats, int count);
+    bool release(uint32_t session, const int* seats, int count);
+    bool purchase(uint32_t session, const int* seats, int count);
+    
+    
+    bool holdAdjacent(uint32_t session, int count, int durationMs, int* seatsOut);
+    bool purchaseAdjacent(uint32_t session, int count);
+    
+    int expireHolds();
+    void syncTo(SeatGrid& grid);
+    
+    SeatState getSeatState(int seat) const;
+    uint32_t getHolder(int seat) const;
+    int getSeatCount() const { return m_seatCount; }
+    
+    static constexpr int MAX_GROUP_SIZE = 32;
+    static constexpr int NO_EXPIRY = 0;
+    
+private:
+    enum : uint64_t
+    {
+        STATE_FREE = 0,
+        STATE_HELD = 1,
+        STATE_COMMITTING = 2,
+        STATE_PURCHASED = 3
+    };
+    
+    static constexpr uint64_t STATE_MASK = 0x3;
+    static constexpr int HOLDER_SHIFT = 2;
+    static constexpr uint64_t HOLDER_MASK = 0x3FFFFFFF;
+    static constexpr int EXPIRY_SHIFT = 32;
+    static constexpr uint32_t NEVER_EXPIRES = 0xFFFFFFFFu;
+    
+    static uint64_t pack(uint64_t state, uint32_t holder, uint32_t expiry)
+    {
+        return state | ((uint64_t)(holder & HOLDER_MASK) << HOLDER_SHIFT) | ((uint64_t)expiry << EXPIRY_SHIFT);
+    }
+    static uint64_t stateOf(uint64_t word) { return word & STATE_MASK; }
+    static uint32_t holderOf(uint64_t word) { return (uint32_t)((word >> HOLDER_SHIFT) & HOLDER_MASK); }
+    static uint32_t expiryOf(uint64_t word) { return (uint32_t)(word >> EXPIRY_SHIFT); }
+    
+    
+    static bool hasExpired(uint32_t expiry, uint32_t now) { return (int32_t)(expiry - now) <= 0; }
+    static bool isTimedHold(uint64_t word) { return stateOf(word) == STATE_HELD && expiryOf(word) != NEVER_EXPIRES; }
+    
+    uint32_t nowMs() const;
+    bool isClaimable(uint64_t word, uint32_t now) const;
+    bool prepareGroup(const int* seats, int count, int* sorted) const;
+    void markDirty(int seat);
+    void setFree(int seat, bool free);
+    void trackHold(int seat, uint64_t word);
+    void untrackHold(int seat);
+    
+    std::unique_ptr<std::atomic<uint64_t>[]> m_seats;
+    std::unique_ptr<std::atomic<uint64_t>[]> m_dirty;
+    std::unique_ptr<std::atomic<uint64_t>[]> m_timedHolds;
+    std::unique_ptr<std::atomic<uint64_t>[]> m_freeBits;
+    std::unique_ptr<std::atomic<int>[]> m_rowFree;
+    int m_seatCount;
+    int m_dirtyWords;
+    int m_wordsPerRow;
+    int m_rows;
+    int m_cols;
+    
+    std::atomic<uint32_t> m_nextSession;
+    std::chrono::steady_clock::time_point m_epoch;
+};
@@ -4,6 +4,7 @@
 #include <glm/gtc/matrix_transform.hpp>
 #include <vector>
 #include "AABB.h"
+#include "CameraCollider.h"
 
 class Camera
 {
@@ -29,7 +30,7 @@ public:
     void setBounds(const AABB& bounds) { m_bounds = bounds; }
     const AABB& getBounds() const { return m_bounds; }
     
-    void setAdditionalBounds(const std::vector<AABB>& additionalBounds) { m_additionalBounds = additionalBounds; }
+    void setAdditionalBounds(const std::vector<AABB>& additionalBounds) { m_collider.setColliders(additionalBounds); }
 
     void setMouseSensitivity(float sensitivity) { m_mouseSensitivity = sensitivity; }
     void setMoveSpeed(float speed) { m_moveSpeed = speed; }
@@ -60,5 +61,5 @@ private:
 
     AABB m_bounds;
     float m_boundsPadding;
-    std::vector<AABB> m_additionalBounds;  
+    CameraCollider m_collider;
 };
@@ -0,0 +1,49 @@
+﻿#pragma once
+
+#include "AABB.h"
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <vector>
+
+class CameraCollider
+{
+public:
+    CameraCollider();
+    
+    void setColliders(const std::vector<AABB>& colliders);
+    const std::vector<AABB>& getColliders() const { return m_colliders; }
+    
+    glm::vec3 resolve(const glm::vec3& currentPosition, const glm::vec3& desiredPosition);
+    
+    int getCellCount() const { return m_cellsX * m_cellsZ; }
+    int getLastCandidateCount() const { return (int)m_candidates.size(); }
+    
+private:
+    void buildGrid();
+    void gatherCandidates(const glm::vec2& areaMin, const glm::vec2& areaMax);
+    bool sweepCircle(const glm::vec2& start, const glm::vec2& move, const AABB& bound,
+                     float& timeOfImpact, glm::vec2& normal) const;
+    
+    std::vector<AABB> m_colliders;
+    
+    
+    glm::vec2 m_gridMin;
+    float m_cellSize;
+    float m_inverseCellSize;
+    int m_cellsX;
+    int m_cellsZ;
+    std::vector<uint32_t> m_cellStart;
+    std::vector<int> m_cellEntries;
+    
+    std::vector<int> m_candidates;
+    std::vector<uint32_t> m_visitStamps;
+    uint32_t m_visitStamp;
+    
+    static constexpr float CAMERA_RADIUS = 0.30f;
+    static constexpr float EPSILON = 0.001f;
+    static constexpr float MAX_STEP_HEIGHT = 0.4f;
+    static constexpr float SKIN_WIDTH = 0.001f;
+    static constexpr int MAX_SLIDE_ITERATIONS = 4;
+    static constexpr float CELL_SIZE = 2.0f;
+    static constexpr int MAX_CELLS_PER_AXIS = 256;
+};
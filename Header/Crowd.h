@@ -0,0 +1,134 @@
+﻿#pragma once
+
+#include "SpatialHash.h"
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <vector>
+
+class HallNavigation;
+class JobSystem;
+
+enum class CrowdPhase : uint8_t
+{
+    EnterToRow,
+    EnterToSeat,
+    Seated,
+    ExitToAisle,
+    ExitToDoor,
+    Exited,
+    Count
+};
+
+class Crowd
+{
+public:
+    Crowd();
+    
+    void setNavigation(const HallNavigation* navigation);
+    void reserve(int capacity);
+    void clear();
+    
+    int spawn(const glm::vec3& doorPos, const glm::vec3& seatPos, const glm::vec3& baseColor, int textureIndex);
+    void queueSpawn(const glm::vec3& doorPos, const glm::vec3& seatPos, const glm::vec3& baseColor, int textureIndex);
+    void clearSpawnQueue();
+    void update(float deltaTime, JobSystem* jobs = nullptr);
+    void startExiting();
+    
+    bool isAreaClear(const glm::vec3& point, float radius) const;
+    
+    int size() const { return (int)m_positions.size(); }
+    int getSeatedCount() const { return m_seatedCount; }
+    int getExitedCount() const { return m_exitedCount; }
+    int getQueuedCount() const { return (int)(m_spawnQueue.size() - m_spawnHead); }
+    bool allSeated() const { return size() > 0 && getQueuedCount() == 0 && m_seatedCount == size(); }
+    bool allExited() const { return getQueuedCount() == 0 && m_exitedCount == size(); }
+    
+    const std::vector<glm::vec3>& getPositions() const { return m_positions; }
+    const std::vector<float>& getRotations() const { return m_rotations; }
+    const std::vector<glm::vec3>& getColors() const { return m_colors; }
+    const std::vector<int>& getTextureIndices() const { return m_textureIndices; }
+    CrowdPhase getPhase(int index) const { return m_phases[index]; }
+    
+    glm::vec3 getInterpolatedPosition(int index, float alpha) const;
+    float getInterpolatedRotation(int index, float alpha) const;
+    
+private:
+    std::vector<glm::vec3> m_positions;
+    std::vector<glm::vec3> m_doorPositions;
+    std::vector<glm::vec3> m_seatPositions;
+    std::vector<float> m_rotations;
+    std::vector<float> m_speeds;
+    std::vector<glm::vec3> m_colors;
+    std::vector<int> m_textureIndices;
+    std::vector<int> m_accesses;
+    std::vector<CrowdPhase> m_phases;
+    std::vector<float> m_waitTimes;
+    std::vector<int> m_pathSteps;
+    
+    
+    std::vector<int> m_phaseLists[(int)CrowdPhase::Count];
+    std::vector<int> m_transitions[(int)CrowdPhase::Count];
+    std::vector<uint8_t> m_arrived;
+    
+    
+    std::vector<glm::vec3> m_previousPositions;
+    std::vector<float> m_previousRotations;
+    std::vector<int> m_previousPathSteps;
+    std::vector<int> m_activeIndices;
+    SpatialHash m_spatialHash;
+    
+    
+    struct SpawnRequest
+    {
+        glm::vec3 doorPosition;
+        glm::vec3 seatPosition;
+        glm::vec3 color;
+        int textureIndex;
+    };
+    std::vector<SpawnRequest> m_spawnQueue;
+    size_t m_spawnHead;
+    float m_spawnTimer;
+    
+    const HallNavigation* m_navigation;
+    
+    int m_seatedCount;
+    int m_exitedCount;
+    
+    static constexpr float DEFAULT_SPEED = 2.0f;
+    static constexpr float CLIMB_SPEED = 1.5f;
+    static constexpr float EPSILON = 0.05f;
+    static constexpr float HALF_PERSON_HEIGHT = 0.6f;
+    static constexpr float PERSON_RADIUS = 0.25f;
+    static constexpr float QUEUE_DISTANCE = 0.8f;
+    static constexpr float YIELD_TIMEOUT = 2.0f;
+    static constexpr float PUSH_THROUGH_TIME = 0.75f;
+    static constexpr int PARALLEL_GRAIN_SIZE = 1024;
+    static constexpr float SPAWN_INTERVAL = 1.0f;
+    static constexpr float DOOR_CLEARANCE = 0.8f;
+    
+    template <typename StepFunction>
+    void runPhase(CrowdPhase phase, CrowdPhase next, JobSystem* jobs, StepFunction step);
+    
+    bool stepEnterToRow(int i, float deltaTime);
+    bool stepEnterToSeat(int i, float deltaTime);
+    bool stepExitToAisle(int i, float deltaTime);
+    bool stepExitToDoor(int i, float deltaTime);
+    
+    glm::vec2 nextWaypoint(int i, const glm::vec3& position, int pathStep, bool& isFinal) const;
+    void followGround(int i, float deltaTime);
+    
+    void releaseQueuedSpawn(float deltaTime);
+    void snapshotPreviousState();
+    void rebuildSpatialHash();
+    glm::vec2 travelDirection(int index) const;
+    bool isBlocked(int index) const;
+    bool waitIfBlocked(int index, float deltaTime);
+    
+    void queueTransition(int index, CrowdPhase next);
+    void applyTransitions();
+    
+    static bool moveToward(float& current, float target, float speed, float dt);
+    static bool moveTowardPoint(glm::vec3& position, const glm::vec2& target, float step);
+    static bool isAhead(const glm::vec2& offset, const glm::vec2& direction);
+    static int phaseRank(CrowdPhase phase);
+};
@@ -0,0 +1,50 @@
+﻿#pragma once
+
+#include <glm/glm.hpp>
+
+class HumanMesh;
+class Shader;
+
+struct CrowdInstance
+{
+    glm::vec4 positionRotation;
+    float layer;
+    float padding[3];
+};
+
+class CrowdRenderer
+{
+public:
+    CrowdRenderer();
+    ~CrowdRenderer();
+
+    bool init(HumanMesh* mesh, Shader* shader);
+    void cleanup();
+
+    CrowdInstance* beginFrame(int count);
+    void draw(int count, const glm::vec3& personScale);
+
+    bool isInitialized() const { return m_VAO != 0; }
+    bool isPersistentlyMapped() const { return m_persistent; }
+
+private:
+    HumanMesh* m_mesh;
+    Shader* m_shader;
+
+    unsigned int m_VAO;
+    unsigned int m_instanceVBO;
+    int m_capacity;
+    bool m_persistent;
+
+    
+    static constexpr int REGION_COUNT = 3;
+    CrowdInstance* m_mapped;
+    void* m_fences[REGION_COUNT];
+    int m_region;
+
+    CrowdInstance* m_staging;
+
+    void allocate(int capacity);
+    void releaseBuffer();
+    void bindInstanceAttributes(size_t byteOffset);
+};
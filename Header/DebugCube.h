@@ -12,6 +12,14 @@ public:
     void draw();
     void cleanup();
 
+    void bindVertexAttributes() const;
+    int getVertexCount() const { return VERTEX_COUNT; }
+
+    static const float* getVertexData();
+    
+    static constexpr int VERTEX_COUNT = 36;
+    static constexpr int FLOATS_PER_VERTEX = 6;
+
 private:
     GLuint m_VAO;
     GLuint m_VBO;
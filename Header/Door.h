@@ -1,5 +1,6 @@
 ﻿#pragma once
 
+#include "AABB.h"
 #include <glm/glm.hpp>
 
 class Shader;
@@ -19,9 +20,11 @@ public:
     bool isOpen() const { return m_isOpen; }
     bool isAnimating() const { return m_currentAngle != m_targetAngle; }
     
-    void draw(Shader* shader, const glm::mat4& view, const glm::mat4& projection, const glm::vec3& viewPos);
+    void draw(Shader* shader, float interpolation = 1.0f);
     
     const glm::vec3& getPosition() const { return m_position; }
+    void setPosition(const glm::vec3& position);
+    AABB getBounds() const;
     
 private:
     bool m_isOpen;
@@ -32,6 +35,7 @@ private:
     
     
     float m_currentAngle;  
+    float m_previousAngle;
     float m_targetAngle;   
     float m_rotationSpeed; 
     
@@ -0,0 +1,45 @@
+﻿#pragma once
+
+#include "ImageDecodePool.h"
+#include "PixelUploadBuffer.h"
+#include <string>
+#include <vector>
+
+class FilmStream
+{
+public:
+    FilmStream();
+    ~FilmStream();
+
+    bool init(const std::vector<std::string>& framePaths, int ringSize);
+    void cleanup();
+
+    void seek(int frame);
+    void update(int currentFrame, double budgetMs);
+
+    bool isFrameResolved(int frame) const;
+    int layerOfFrame(int frame) const;
+
+    int getFrameCount() const { return (int)m_framePaths.size(); }
+    int getRingSize() const { return m_ringSize; }
+    unsigned int getTextureArray() const { return m_textureArray; }
+    size_t getResidentBytes() const { return (size_t)m_width * m_height * 4 * m_ringSize; }
+
+private:
+    std::vector<std::string> m_framePaths;
+    ImageDecodePool m_decodePool;
+    PixelUploadBuffer m_uploadBuffer;
+
+    unsigned int m_textureArray;
+    int m_width;
+    int m_height;
+    int m_ringSize;
+
+    std::vector<int> m_layerFrame;
+    std::vector<bool> m_layerValid;
+    int m_windowStart;
+    int m_nextRequest;
+
+    void requestWindow();
+    void uploadFrame(const DecodedImage& image);
+};
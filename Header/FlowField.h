@@ -0,0 +1,29 @@
+﻿#pragma once
+
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <vector>
+
+class NavGrid;
+
+class FlowField
+{
+public:
+    FlowField();
+
+    void build(const NavGrid& grid, const std::vector<int>& goalCells, bool keepDistances = false);
+
+    bool isReachable(int cell) const { return m_directions[cell] != UNREACHABLE; }
+    bool isGoal(int cell) const { return m_directions[cell] == GOAL; }
+    bool hasDistances() const { return !m_distances.empty(); }
+    float getDistance(int cell) const { return m_distances[cell]; }
+
+    int nextCell(const NavGrid& grid, int cell) const;
+
+    static constexpr uint8_t GOAL = 8;
+    static constexpr uint8_t UNREACHABLE = 255;
+
+private:
+    std::vector<uint8_t> m_directions;
+    std::vector<float> m_distances;
+};
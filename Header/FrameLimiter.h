@@ -1,23 +1,75 @@
 ﻿#pragma once
 
+#include <chrono>
+
+struct FrameStats
+{
+    double fps;
+    double averageFrameTime;
+    double minFrameTime;
+    double maxFrameTime;
+    double averageWorkTime;
+    double averageOversleep;
+    int frameCount;
+    
+    FrameStats()
+        : fps(0.0)
+        , averageFrameTime(0.0)
+        , minFrameTime(0.0)
+        , maxFrameTime(0.0)
+        , averageWorkTime(0.0)
+        , averageOversleep(0.0)
+        , frameCount(0)
+    {}
+};
+
 class FrameLimiter
 {
 public:
     FrameLimiter(double targetFPS = 75.0);
+    ~FrameLimiter();
 
     void beginFrame();
     void endFrame();
+    
+    void setVSync(bool enabled, double refreshRate);
+    bool isVSyncPaced() const { return m_vsyncPaced; }
 
     float getDeltaTime() const;
     double getCurrentFPS() const;
+    const FrameStats& getStats() const { return m_stats; }
+    double getSleepSlack() const { return m_sleepSlack; }
 
 private:
+    typedef std::chrono::steady_clock Clock;
+    
     double m_targetFrameTime;
-    double m_frameStartTime;
+    Clock::time_point m_frameStartTime;
+    Clock::time_point m_lastFrameEnd;
+    Clock::time_point m_nextDeadline;
+    bool m_hasDeadline;
+    bool m_hasLastFrame;
+    bool m_vsyncPaced;
     float m_deltaTime;
     
     
-    double m_fpsTimer;
-    int m_frameCount;
-    double m_currentFPS;
+    double m_sleepSlack;
+    double m_oversleepEstimate;
+    
+    
+    double m_windowTime;
+    double m_windowWorkTime;
+    double m_windowOversleep;
+    double m_windowMin;
+    double m_windowMax;
+    int m_windowFrames;
+    int m_windowSleeps;
+    FrameStats m_stats;
+    
+    void waitUntil(Clock::time_point deadline);
+    void recordFrame(double frameTime, double workTime);
+    
+    static constexpr double MIN_SLEEP_SLACK = 0.0002;
+    static constexpr double MAX_SLEEP_SLACK = 0.004;
+    static constexpr double STATS_WINDOW = 1.0;
 };
@@ -0,0 +1,35 @@
+﻿#pragma once
+
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+
+struct Light;
+
+class FrameUniforms
+{
+public:
+    FrameUniforms();
+    ~FrameUniforms();
+    
+    void init();
+    void update(const glm::mat4& view, const glm::mat4& projection,
+                const Light& light, const glm::vec3& viewPos);
+    void cleanup();
+    
+private:
+    
+    struct Block
+    {
+        glm::mat4 view;
+        glm::mat4 projection;
+        glm::vec3 lightPos;
+        float lightIntensity;
+        glm::vec3 lightColor;
+        GLint lightEnabled;
+        glm::vec3 viewPos;
+        float padding;
+    };
+    
+    GLuint m_UBO;
+    bool m_initialized;
+};
@@ -0,0 +1,54 @@
+﻿#pragma once
+
+#include <cstdint>
+
+class GpuProfiler
+{
+public:
+    GpuProfiler();
+    ~GpuProfiler();
+    
+    void init();
+    void cleanup();
+    
+    void beginFrame();
+    void beginZone(const char* name);
+    void endZone();
+    
+private:
+    struct Query
+    {
+        unsigned int id;
+        const char* name;
+        int64_t cpuStart;
+    };
+    
+    static constexpr int FRAME_LATENCY = 4;
+    static constexpr int MAX_ZONES = 16;
+    
+    Query m_queries[FRAME_LATENCY][MAX_ZONES];
+    int m_zoneCounts[FRAME_LATENCY];
+    int m_frame;
+    int m_depth;
+    bool m_active;
+    bool m_initialized;
+    
+    void collect(int frame);
+};
+
+class GpuProfileZone
+{
+public:
+    GpuProfileZone(GpuProfiler* profiler, const char* name);
+    ~GpuProfileZone();
+    
+private:
+    GpuProfiler* m_profiler;
+    
+    GpuProfileZone(const GpuProfileZone&);
+    GpuProfileZone& operator=(const GpuProfileZone&);
+};
+
+#define PROFILE_GPU_ZONE(profiler, name) \
+    ProfileZone PROFILE_CONCAT(profileZone, __LINE__)(name); \
+    GpuProfileZone PROFILE_CONCAT(gpuProfileZone, __LINE__)(profiler, name)
@@ -0,0 +1,69 @@
+﻿#pragma once
+
+#include "AABB.h"
+#include "FlowField.h"
+#include "NavGrid.h"
+#include <glm/glm.hpp>
+#include <vector>
+
+struct SeatLayout;
+
+struct RowAccess
+{
+    glm::vec3 position;
+    int cell;
+    int row;
+};
+
+class HallNavigation
+{
+public:
+    HallNavigation();
+
+    bool build(const AABB& floor,
+               const SeatLayout& layout,
+               const std::vector<glm::vec3>& seatPositions,
+               const std::vector<AABB>& seatBounds,
+               const std::vector<AABB>& surfaces,
+               const glm::vec3& doorPosition);
+
+    bool isValid() const { return m_valid; }
+
+    const NavGrid& getGrid() const { return m_grid; }
+    const FlowField& getExitField() const { return m_exitField; }
+    int getEntryPathLength(int access) const { return m_pathStarts[access + 1] - m_pathStarts[access]; }
+    int getEntryPathCell(int access, int step) const { return m_pathCells[m_pathStarts[access] + step]; }
+    int getEntryPathCellCount() const { return (int)m_pathCells.size(); }
+    const RowAccess& getAccess(int access) const { return m_accesses[access]; }
+    int getAccessCount() const { return (int)m_accesses.size(); }
+    const glm::vec3& getDoorPosition() const { return m_doorPosition; }
+
+    int findAccess(const glm::vec3& seatPosition) const;
+    float groundHeight(const glm::vec3& position) const { return m_grid.heightAt(position); }
+
+    static constexpr float CELL_SIZE = 0.5f;
+    static constexpr float DOOR_RADIUS = 0.75f;
+
+private:
+    NavGrid m_grid;
+    FlowField m_exitField;
+    std::vector<RowAccess> m_accesses;
+
+    
+    std::vector<int> m_pathCells;
+    std::vector<int> m_pathStarts;
+
+    
+    std::vector<int> m_sideAccesses;
+    std::vector<float> m_sectionMinX;
+
+    glm::vec3 m_doorPosition;
+    float m_originZ;
+    float m_rowSpacing;
+    int m_rows;
+    int m_sections;
+    bool m_valid;
+
+    int addAccess(int row, float x, float seatX, float rowZ, std::vector<int>& cellAccesses);
+    void buildEntryPaths();
+};
@@ -12,20 +12,28 @@ public:
 
     bool loadOBJ(const std::string& objPath);
     bool loadTexture(const std::string& texPath);
-    bool loadMultipleTextures(const std::string& basePath, int count);
+    bool loadTextureArray(const std::string& basePath, int count, int layerSize);
     void draw() const;
+    void bindVertexAttributes() const;
+    int getIndexCount() const { return m_indexCount; }
     void cleanup();
 
     GLuint getTextureID() const { return m_textureID; }
-    GLuint getTextureID(int index) const;
-    int getTextureCount() const { return (int)m_textureIDs.size(); }
+    GLuint getTextureArrayID() const { return m_textureArrayID; }
+    int getTextureCount() const { return m_layerCount; }
 
 private:
+    void uploadMesh(const float* vertices, int vertexCount,
+                    const unsigned int* indices, int indexCount);
+
     GLuint m_VAO;
     GLuint m_VBO;
+    GLuint m_EBO;
     int    m_vertexCount;
+    int    m_indexCount;
     bool   m_initialized;
 
     GLuint m_textureID;
-    std::vector<GLuint> m_textureIDs;
+    GLuint m_textureArrayID;
+    int    m_layerCount;
 };
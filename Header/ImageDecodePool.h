@@ -0,0 +1,62 @@
+﻿#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+struct DecodedImage
+{
+    int id;
+    int width;
+    int height;
+    int channels;
+    unsigned char* pixels;
+
+    DecodedImage() : id(-1), width(0), height(0), channels(0), pixels(nullptr) {}
+};
+
+class ImageDecodePool
+{
+public:
+    ImageDecodePool();
+    ~ImageDecodePool();
+
+    ImageDecodePool(const ImageDecodePool&) = delete;
+    ImageDecodePool& operator=(const ImageDecodePool&) = delete;
+
+    bool init(int workerCount = 0);
+    void shutdown();
+
+    void request(int id, const std::string& path, bool flipVertically, int desiredChannels);
+    bool popCompleted(DecodedImage& image);
+    bool waitCompleted(DecodedImage& image);
+    void cancelPending();
+
+    int getPendingCount() const;
+    int getWorkerCount() const { return (int)m_workers.size(); }
+
+    static void release(DecodedImage& image);
+
+private:
+    struct Request
+    {
+        int id;
+        std::string path;
+        bool flipVertically;
+        int desiredChannels;
+    };
+
+    void workerLoop();
+
+    std::vector<std::thread> m_workers;
+    std::deque<Request> m_requests;
+    std::deque<DecodedImage> m_completed;
+    mutable std::mutex m_mutex;
+    std::condition_variable m_wake;
+    std::condition_variable m_completedSignal;
+    int m_inFlight;
+    bool m_stopping;
+};
@@ -0,0 +1,59 @@
+﻿#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class JobSystem
+{
+public:
+    typedef std::function<void(int begin, int end)> RangeFunction;
+
+    JobSystem();
+    ~JobSystem();
+
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    bool init(int workerCount = 0);
+    void shutdown();
+
+    int getWorkerCount() const { return (int)m_workers.size(); }
+
+    void parallelFor(int count, int grainSize, const RangeFunction& body);
+
+private:
+    struct Job
+    {
+        const RangeFunction* body;
+        int begin;
+        int end;
+        std::atomic<int>* remaining;
+    };
+
+    struct WorkQueue
+    {
+        std::mutex mutex;
+        std::deque<Job> jobs;
+    };
+
+    std::vector<std::thread> m_workers;
+    std::vector<std::unique_ptr<WorkQueue>> m_queues;
+
+    std::mutex m_sleepMutex;
+    std::condition_variable m_wake;
+    std::atomic<int> m_queuedJobs;
+    std::atomic<bool> m_stopping;
+
+    void workerLoop(int queueIndex);
+    int currentQueueIndex() const;
+    bool tryRunJob(int queueIndex);
+    bool popLocal(int queueIndex, Job& job);
+    bool steal(int thiefIndex, Job& job);
+    void execute(const Job& job);
+};
@@ -1,17 +1,42 @@
 ﻿#pragma once
 
-#include <iostream>
+#include <atomic>
 #include <string>
 
-#define LOG_INFO(msg) std::cout << "[INFO] " << msg << std::endl
-#define LOG_WARNING(msg) std::cout << "[WARNING] " << msg << std::endl
-#define LOG_ERROR(msg) std::cerr << "[ERROR] " << msg << std::endl
+enum class LogLevel : int
+{
+    Info,
+    Warning,
+    Error
+};
+
+#define LOG_AT(level, msg) do { if (Log::isEnabled(level)) Log::write(level, msg); } while (0)
+#define LOG_INFO(msg) LOG_AT(LogLevel::Info, msg)
+#define LOG_WARNING(msg) LOG_AT(LogLevel::Warning, msg)
+#define LOG_ERROR(msg) LOG_AT(LogLevel::Error, msg)
+
+#define LOG_INFOF(...) do { if (Log::isEnabled(LogLevel::Info)) Log::writef(LogLevel::Info, __VA_ARGS__); } while (0)
+#define LOG_WARNINGF(...) do { if (Log::isEnabled(LogLevel::Warning)) Log::writef(LogLevel::Warning, __VA_ARGS__); } while (0)
+#define LOG_ERRORF(...) do { if (Log::isEnabled(LogLevel::Error)) Log::writef(LogLevel::Error, __VA_ARGS__); } while (0)
 
 class Log
 {
 public:
     static void init();
+    static void shutdown();
+    
+    static void setLevel(LogLevel level) { s_minLevel.store((int)level, std::memory_order_relaxed); }
+    static bool isEnabled(LogLevel level) { return (int)level >= s_minLevel.load(std::memory_order_relaxed); }
+    static void setRateLimit(int messagesPerSecond);
+    
+    static void write(LogLevel level, const char* message);
+    static void write(LogLevel level, const std::string& message);
+    static void writef(LogLevel level, const char* format, ...);
+    
     static void info(const std::string& message);
     static void warning(const std::string& message);
     static void error(const std::string& message);
+
+private:
+    static std::atomic<int> s_minLevel;
 };
@@ -0,0 +1,30 @@
+﻿#pragma once
+
+#include <cstddef>
+#include <string>
+
+class MappedFile
+{
+public:
+    MappedFile();
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool open(const std::string& path);
+    void close();
+
+    bool isOpen() const { return m_data != nullptr; }
+    const unsigned char* getData() const { return m_data; }
+    size_t getSize() const { return m_size; }
+
+private:
+    const unsigned char* m_data;
+    size_t m_size;
+
+#ifdef _WIN32
+    void* m_fileHandle;
+    void* m_mappingHandle;
+#endif
+};
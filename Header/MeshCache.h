@@ -0,0 +1,44 @@
+﻿#pragma once
+
+#include "MappedFile.h"
+#include "ObjParser.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+struct MeshCacheHeader
+{
+    char     magic[4];
+    uint32_t version;
+    uint32_t floatsPerVertex;
+    uint32_t vertexCount;
+    uint32_t indexCount;
+    uint32_t reserved;
+    uint64_t sourceSize;
+    int64_t  sourceMtime;
+};
+
+class MeshCache
+{
+public:
+    static constexpr uint32_t VERSION = 2;
+
+    MeshCache();
+
+    bool open(const std::string& objPath, int floatsPerVertex);
+    void close();
+
+    const float* getVertexData() const;
+    int getVertexCount() const;
+    const unsigned int* getIndexData() const;
+    int getIndexCount() const;
+
+    static std::string cachePathFor(const std::string& objPath);
+    static bool write(const std::string& objPath, const ObjMeshData& mesh);
+
+private:
+    MappedFile m_file;
+    const MeshCacheHeader* m_header;
+
+    static bool querySource(const std::string& objPath, uint64_t& size, int64_t& mtime);
+};
@@ -0,0 +1,55 @@
+﻿#pragma once
+
+#include "AABB.h"
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <vector>
+
+class NavGrid
+{
+public:
+    NavGrid();
+
+    bool build(const AABB& floor, float cellSize,
+               const std::vector<AABB>& surfaces,
+               const std::vector<AABB>& obstacles);
+
+    int getWidth() const { return m_width; }
+    int getDepth() const { return m_depth; }
+    int getCellCount() const { return m_width * m_depth; }
+    float getCellSize() const { return m_cellSize; }
+
+    int cellIndex(int cellX, int cellZ) const { return cellZ * m_width + cellX; }
+    int cellX(int index) const { return index % m_width; }
+    int cellZ(int index) const { return index / m_width; }
+
+    bool contains(int cellX, int cellZ) const;
+    int cellAt(const glm::vec3& position) const;
+    glm::vec3 cellCenter(int index) const;
+
+    bool isWalkable(int index) const { return m_walkable[index] != 0; }
+    float getHeight(int index) const { return m_heights[index]; }
+    float heightAt(const glm::vec3& position) const;
+
+    bool canStep(int from, int to) const;
+
+    uint8_t getLinks(int index) const { return m_links[index]; }
+    int neighbour(int index, int direction) const;
+
+    static constexpr int DIRECTION_COUNT = 8;
+    static constexpr float MAX_STEP_HEIGHT = 0.35f;
+
+private:
+    glm::vec2 m_origin;
+    float m_cellSize;
+    float m_floorY;
+    int m_width;
+    int m_depth;
+
+    std::vector<float> m_heights;
+    std::vector<uint8_t> m_walkable;
+    std::vector<uint8_t> m_links;
+
+    bool cellRange(const AABB& bounds, int& minX, int& maxX, int& minZ, int& maxZ) const;
+    void buildLinks();
+};
@@ -0,0 +1,26 @@
+﻿#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+struct ObjMeshData
+{
+    std::vector<float> vertices;
+    std::vector<unsigned int> indices;
+    int floatsPerVertex;
+
+    ObjMeshData() : floatsPerVertex(0) {}
+
+    int getVertexCount() const { return floatsPerVertex > 0 ? (int)(vertices.size() / floatsPerVertex) : 0; }
+    int getIndexCount() const { return (int)indices.size(); }
+};
+
+class ObjParser
+{
+public:
+    static bool loadFile(const std::string& path, bool withTexCoords, ObjMeshData& mesh);
+    static bool parse(const char* text, size_t length, bool withTexCoords, ObjMeshData& mesh);
+
+    static void normalizeToUnitSize(ObjMeshData& mesh);
+};
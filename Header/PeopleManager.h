@@ -1,6 +1,7 @@
 ﻿#pragma once
 
-#include "Person.h"
+#include "AABB.h"
+#include "Crowd.h"
 #include <vector>
 #include <memory>
 #include <glm/glm.hpp>
@@ -9,6 +10,9 @@ class SeatGrid;
 class Shader;
 class DebugCube;
 class HumanMesh;
+class CrowdRenderer;
+class JobSystem;
+class HallNavigation;
 
 class PeopleManager
 {
@@ -17,8 +21,13 @@ public:
     ~PeopleManager();
     
     
+#ifndef KOSTUR_HEADLESS_ONLY
     void setHumanMesh(HumanMesh* mesh);
     void setHumanShader(Shader* shader);
+    void setCrowdShader(Shader* shader);
+#endif
+    void setJobSystem(JobSystem* jobs);
+    void setNavigation(const HallNavigation* navigation);
     
     
     void spawnPeople(int count, SeatGrid& grid, const glm::vec3& doorPos);
@@ -33,35 +42,32 @@ public:
     void update(float deltaTime);
     
     
-    void draw(Shader& phongShader, const glm::mat4& view, const glm::mat4& projection, 
-              const glm::vec3& viewPos, DebugCube& cubeMesh);
+#ifndef KOSTUR_HEADLESS_ONLY
+    void draw(Shader& phongShader, DebugCube& cubeMesh, float interpolation = 1.0f);
+#endif
     
     
-    bool allSeated() const;
-    bool allExited() const;
-    int getPeopleCount() const { return (int)m_people.size(); }
+    bool allSeated() const { return m_crowd.allSeated(); }
+    bool allExited() const { return m_crowd.allExited(); }
+    int getPeopleCount() const { return m_crowd.size(); }
+    const Crowd& getCrowd() const { return m_crowd; }
+    void getBounds(std::vector<AABB>& bounds) const;
     
     
     void startExiting();
     
 private:
-    std::vector<std::unique_ptr<Person>> m_people;
-    
-    
-    
-    struct SpawnRequest
-    {
-        Seat* targetSeat;
-        glm::vec3 color;
-        int textureIndex;
-    };
-    std::vector<SpawnRequest> m_spawnQueue;
-    glm::vec3 m_doorPos;
-    float m_spawnTimer;
-    static constexpr float SPAWN_INTERVAL = 1.0f;  
+    Crowd m_crowd;
+    JobSystem* m_jobSystem;
     
+#ifndef KOSTUR_HEADLESS_ONLY
     HumanMesh* m_humanMesh;    
     Shader*    m_humanShader;  
+    Shader*    m_crowdShader;
+    std::unique_ptr<CrowdRenderer> m_crowdRenderer;
+    
+    void drawInstanced(float interpolation);
+#endif
     
     
     static constexpr float PERSON_WIDTH = 1.1f;
@@ -0,0 +1,20 @@
+﻿#pragma once
+
+#include <cstddef>
+
+class PixelUploadBuffer
+{
+public:
+    PixelUploadBuffer();
+    ~PixelUploadBuffer();
+
+    PixelUploadBuffer(const PixelUploadBuffer&) = delete;
+    PixelUploadBuffer& operator=(const PixelUploadBuffer&) = delete;
+
+    const void* stage(const void* pixels, size_t byteSize);
+    void finish();
+    void cleanup();
+
+private:
+    unsigned int m_PBO;
+};
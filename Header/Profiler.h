@@ -0,0 +1,90 @@
+﻿#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+struct ProfileStats
+{
+    std::string name;
+    bool gpu;
+    int samples;
+    double average;
+    double p50;
+    double p95;
+    double p99;
+    double max;
+};
+
+class Profiler
+{
+public:
+    static void beginFrame();
+    static void endFrame();
+    
+    static void beginZone(const char* name);
+    static void endZone();
+    
+    static void recordGpuZone(const char* name, int64_t cpuStartNs, double milliseconds);
+    
+    static void startCapture(const std::string& path, int frames);
+    static bool isCapturing() { return s_captureFramesLeft > 0; }
+    
+    static std::vector<ProfileStats> getStats();
+    static void logStats();
+    
+    static int64_t now();
+
+private:
+    struct OpenZone
+    {
+        const char* name;
+        int64_t start;
+    };
+    
+    struct TraceEvent
+    {
+        const char* name;
+        int64_t start;
+        int64_t duration;
+        bool gpu;
+    };
+    
+    struct ZoneSeries
+    {
+        const char* name;
+        bool gpu;
+        double frameTotal;
+        std::vector<float> samples;
+        int next;
+        int count;
+    };
+    
+    static std::vector<OpenZone> s_stack;
+    static std::vector<ZoneSeries> s_series;
+    static std::vector<TraceEvent> s_events;
+    static std::string s_capturePath;
+    static int s_captureFramesLeft;
+    static int64_t s_frameStart;
+    
+    static ZoneSeries& findSeries(const char* name, bool gpu);
+    static void pushSample(ZoneSeries& series, double milliseconds);
+    static void finishCapture();
+    
+    static constexpr int WINDOW_FRAMES = 300;
+};
+
+class ProfileZone
+{
+public:
+    explicit ProfileZone(const char* name) { Profiler::beginZone(name); }
+    ~ProfileZone() { Profiler::endZone(); }
+    
+private:
+    ProfileZone(const ProfileZone&);
+    ProfileZone& operator=(const ProfileZone&);
+};
+
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+#define PROFILE_ZONE(name) ProfileZone PROFILE_CONCAT(profileZone, __LINE__)(name)
@@ -6,16 +6,19 @@ struct Ray
 {
     glm::vec3 origin;
     glm::vec3 direction;  
+    glm::vec3 invDirection;
     
     Ray()
         : origin(0.0f)
         , direction(0.0f, 0.0f, -1.0f)
+        , invDirection(1.0f / direction)
     {
     }
     
     Ray(const glm::vec3& orig, const glm::vec3& dir)
         : origin(orig)
         , direction(glm::normalize(dir))
+        , invDirection(1.0f / direction)
     {
     }
     
@@ -0,0 +1,67 @@
+﻿#pragma once
+
+#include "AABB.h"
+#include "AlignedAllocator.h"
+#include "Ray.h"
+#include <vector>
+
+enum class SimdLevel
+{
+    Scalar,
+    SSE,
+    AVX2
+};
+
+class AABBSoA
+{
+public:
+    static constexpr int LANES = 8;
+    static constexpr int ALIGNMENT = 32;
+
+    AABBSoA();
+
+    void assign(const std::vector<AABB>& boxes);
+    void resize(int count);
+    void clear();
+
+    void set(int index, const AABB& box);
+    AABB get(int index) const;
+
+    int size() const { return m_count; }
+    bool empty() const { return m_count == 0; }
+
+    const float* minX() const { return m_minX.data(); }
+    const float* minY() const { return m_minY.data(); }
+    const float* minZ() const { return m_minZ.data(); }
+    const float* maxX() const { return m_maxX.data(); }
+    const float* maxY() const { return m_maxY.data(); }
+    const float* maxZ() const { return m_maxZ.data(); }
+
+private:
+    typedef std::vector<float, AlignedAllocator<float, ALIGNMENT>> AlignedFloats;
+
+    AlignedFloats m_minX;
+    AlignedFloats m_minY;
+    AlignedFloats m_minZ;
+    AlignedFloats m_maxX;
+    AlignedFloats m_maxY;
+    AlignedFloats m_maxZ;
+    int m_count;
+};
+
+class RayBoxKernel
+{
+public:
+    static SimdLevel getSupportedLevel();
+    static SimdLevel getLevel();
+    static void setLevel(SimdLevel level);
+    static const char* levelName(SimdLevel level);
+
+    static int intersectNearest(const Ray& ray, const AABBSoA& boxes, int first, int count,
+                                float maxDistance, float& tNear);
+    static int intersectNearest(SimdLevel level, const Ray& ray, const AABBSoA& boxes, int first, int count,
+                                float maxDistance, float& tNear);
+
+private:
+    static SimdLevel s_level;
+};
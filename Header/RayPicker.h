@@ -1,12 +1,31 @@
 ﻿#pragma once
 
+#include "AABB.h"
+#include "BVH.h"
 #include "Ray.h"
 #include <glm/glm.hpp>
+#include <vector>
 
-struct AABB;
-struct Seat;
 class SeatGrid;
 
+enum class PickTarget
+{
+    None,
+    Seat,
+    Person,
+    Door,
+    Hall
+};
+
+struct PickResult
+{
+    PickTarget target;
+    int index;
+    float distance;
+    
+    PickResult() : target(PickTarget::None), index(-1), distance(0.0f) {}
+};
+
 class RayPicker
 {
 public:
@@ -30,5 +49,25 @@ public:
     
     
     
-    Seat* pickSeat(const Ray& ray, SeatGrid& grid) const;
+    int pickSeat(const Ray& ray, const SeatGrid& grid) const;
+    
+    
+    void buildScene(const SeatGrid& grid, const std::vector<AABB>& hallBounds);
+    void updatePeople(const std::vector<AABB>& peopleBounds);
+    void setDoorBounds(const AABB& doorBounds) { m_doorBounds = doorBounds; m_hasDoor = true; }
+    
+    PickResult pick(const Ray& ray) const;
+    int pickSeatOccluded(const Ray& ray) const;
+    
+    const BVH& getStaticBVH() const { return m_staticBVH; }
+    const BVH& getPeopleBVH() const { return m_peopleBVH; }
+    
+private:
+    BVH m_staticBVH;
+    BVH m_peopleBVH;
+    int m_seatCount;
+    AABB m_doorBounds;
+    bool m_hasDoor;
+    
+    static constexpr float REBUILD_GROWTH = 2.0f;
 };
@@ -10,6 +10,7 @@
 class Shader;
 class DebugCube;
 class Camera;
+struct SeatLayout;
 
 struct SceneObject
 {
@@ -49,26 +50,46 @@ public:
     Scene();
     ~Scene();
     
-    void init(DebugCube* cubeMesh);
+    void init(DebugCube* cubeMesh, const SeatLayout& layout);
     void update(float deltaTime);
-    void draw(const glm::mat4& view, const glm::mat4& projection, 
-              Shader* phongShader, Shader* basicShader, const glm::vec3& viewPos);
+    void draw(Shader* phongShader, Shader* basicShader);
+    
+    
+    void setStaticShader(Shader* shader) { m_staticShader = shader; }
+    void addStaticObject(const SceneObject& object);
     
     
     Light& getRoomLight() { return m_roomLight; }
     Light& getScreenLight() { return m_screenLight; }
+    const Light& getActiveLight() const;
     
     
     std::vector<AABB> getCollidableBounds() const;
+    std::vector<AABB> getOccluderBounds() const;
+    AABB getFloorBounds() const;
+    const AABB& getHallBounds() const { return m_hallBounds; }
+    const glm::vec3& getDoorPosition() const { return m_doorPosition; }
+    const glm::vec3& getScreenPosition() const { return m_screenPosition; }
     
 private:
-    void createHallGeometry();
+    void computeHallExtents(const SeatLayout& layout);
+    void createHallGeometry(const SeatLayout& layout);
     void createLights();
     
+    void rebuildStaticBatch();
+    void releaseStaticBatch();
+    
     DebugCube* m_cubeMesh;  
     std::vector<SceneObject> m_objects;
     
     
+    Shader* m_staticShader;
+    unsigned int m_staticVAO;
+    unsigned int m_staticVBO;
+    int m_staticVertexCount;
+    bool m_staticBatchDirty;
+    
+    
     Light m_roomLight;
     Light m_screenLight;
     
@@ -85,4 +106,17 @@ private:
     
     int m_firstPlatformIndex;  
     int m_firstStairIndex;     
+    int m_stairCount;
+    
+    
+    AABB m_hallBounds;
+    glm::vec3 m_doorPosition;
+    glm::vec3 m_screenPosition;
+    
+    static constexpr float FLOOR_Y = 0.5f;
+    static constexpr float CEILING_Y = 5.0f;
+    static constexpr float SIDE_CLEARANCE = 2.0f;
+    static constexpr float FRONT_CLEARANCE = 11.0f;
+    static constexpr float BACK_CLEARANCE = 0.7f;
+    static constexpr float DOOR_FROM_FRONT = 4.0f;
 };
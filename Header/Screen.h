@@ -1,6 +1,12 @@
 ﻿#pragma once
 
+#ifndef KOSTUR_HEADLESS_ONLY
+#include "FilmStream.h"
+#include "ImageDecodePool.h"
+#include "PixelUploadBuffer.h"
+#endif
 #include <glm/glm.hpp>
+#include <string>
 #include <vector>
 
 class Shader;
@@ -11,17 +17,29 @@ public:
     Screen();
     ~Screen();
     
+#ifndef KOSTUR_HEADLESS_ONLY
     void init();
+    void uploadPendingFrames();
+    void draw();
+#endif
+    void initHeadless();
     void startPlayback();
     void stopAndResetToWhite();
     void update(float deltaTime);
-    void draw(const glm::mat4& view, const glm::mat4& projection);
     
     bool isPlaying() const { return m_playing; }
+    bool isStreaming() const { return m_streaming; }
+    int getFrameCount() const;
+    int getUploadedFrameCount() const { return m_uploadedFrames; }
+    void setPosition(const glm::vec3& position) { m_position = position; }
     
 private:
-    std::vector<unsigned int> m_filmTextures;
-    unsigned int m_whiteTexture;
+    bool m_streaming;
+    bool m_headless;
+    int m_headlessFrameCount;
+    int m_uploadedFrames;
+    int m_resolvedFrames;
+    double m_loadStartTime;
     
     bool m_playing;
     float m_timer;
@@ -31,6 +49,19 @@ private:
     bool m_debugOverlay;
     
     static constexpr float FILM_DURATION = 20.0f;
+    static constexpr int MAX_FILM_FRAMES = 100;
+    static constexpr double UPLOAD_BUDGET_MS = 2.0;
+    static constexpr int RESIDENT_FRAME_LIMIT = 24;
+    static constexpr int STREAM_RING_SIZE = 8;
+    
+#ifndef KOSTUR_HEADLESS_ONLY
+    std::vector<unsigned int> m_filmTextures;
+    std::vector<bool> m_frameResolved;
+    unsigned int m_whiteTexture;
+    
+    ImageDecodePool m_decodePool;
+    PixelUploadBuffer m_uploadBuffer;
+    FilmStream m_filmStream;
     
     unsigned int m_VAO;
     unsigned int m_VBO;
@@ -38,12 +69,19 @@ private:
     unsigned int m_overlayVBO;
     
     Shader* m_shader;
+#endif
     
     glm::vec3 m_position;
     glm::vec2 m_size;
     
-    void loadFilmTextures();
+    std::vector<std::string> findFilmFramePaths() const;
+    bool isFrameResolved(int frame) const;
+#ifndef KOSTUR_HEADLESS_ONLY
+    void queueFilmFrames();
+    void uploadDecodedFrames(double budgetMs);
+    unsigned int uploadFrameTexture(const DecodedImage& image);
+    unsigned int frameTexture(int frame) const;
     void createWhiteTexture();
     void setupScreenQuad();
-    unsigned int loadTexture(const char* path);
+#endif
 };
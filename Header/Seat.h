@@ -1,8 +1,5 @@
 ﻿#pragma once
 
-#include <glm/glm.hpp>
-#include "Header/AABB.h"
-
 enum class SeatState
 {
     Free,
@@ -10,29 +7,7 @@ enum class SeatState
     Purchased
 };
 
-struct Seat
+inline bool isSeatOccupied(SeatState state)
 {
-    int row;
-    int col;
-    SeatState state;
-    glm::vec3 position;    
-    AABB bounds;           
-    
-    Seat()
-        : row(0)
-        , col(0)
-        , state(SeatState::Free)
-        , position(0.0f)
-        , bounds()
-    {
-    }
-    
-    Seat(int r, int c, const glm::vec3& pos, const AABB& b)
-        : row(r)
-        , col(c)
-        , state(SeatState::Free)
-        , position(pos)
-        , bounds(b)
-    {
-    }
-};
+    return state == SeatState::Reserved || state == SeatState::Purchased;
+}
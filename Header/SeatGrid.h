@@ -1,14 +1,12 @@
 ﻿#pragma once
 
 #include "Seat.h"
+#include "SeatLayout.h"
 #include "AABB.h"
 #include <glm/glm.hpp>
+#include <cstdint>
 #include <vector>
 
-class Shader;
-class DebugCube;
-class SeatMesh;
-
 struct StepPlatform
 {
     glm::vec3 position;     
@@ -34,25 +32,44 @@ struct StepPlatform
 class SeatGrid
 {
 public:
-    static constexpr int ROWS = 5;
-    static constexpr int COLS = 10;
-    
     SeatGrid();
     ~SeatGrid();
     
-    void init(
-        DebugCube* cubeMesh,
-        SeatMesh* seatMesh,
-        const glm::vec3& origin,
-        float seatSpacingX,
-        float seatSpacingZ,
-        float rowElevationStep
-    );
+    void init(const SeatLayout& layout);
+    
+    
+    const SeatLayout& getLayout() const { return m_layout; }
+    int getRows() const { return m_layout.rows; }
+    int getCols() const { return m_layout.cols; }
+    int getSeatCount() const { return (int)m_seatStates.size(); }
+    
+    int seatIndex(int row, int col) const;
+    int seatRow(int index) const { return index / m_layout.cols; }
+    int seatCol(int index) const { return index % m_layout.cols; }
+    
+    
+    const std::vector<glm::vec3>& getSeatPositions() const { return m_seatPositions; }
+    const std::vector<AABB>& getSeatBounds() const { return m_seatBounds; }
+    const std::vector<SeatState>& getSeatStates() const { return m_seatStates; }
+    const std::vector<int>& getSeatSections() const { return m_seatSections; }
+    
+    SeatState getSeatState(int index) const { return m_seatStates[index]; }
+    const glm::vec3& getSeatPosition(int index) const { return m_seatPositions[index]; }
+    const glm::vec3& getSeatHalfExtents() const { return m_seatHalfExtents; }
+    
     
-    void draw(Shader* phongShader, const glm::mat4& view, const glm::mat4& projection, const glm::vec3& viewPos);
+    unsigned int getLayoutVersion() const { return m_layoutVersion; }
+    unsigned int getStateVersion() const { return m_stateVersion; }
     
-    Seat* getSeat(int row, int col);
-    const Seat* getSeat(int row, int col) const;
+    void setSeatState(int index, SeatState state);
+    void resetAllSeats();
+    int countOccupiedSeats() const;
+    int countSeats(SeatState state) const { return m_stateCounts[(int)state]; }
+    int getRowFreeCount(int row) const { return m_rowFreeCounts[row]; }
+    void getOccupiedSeats(std::vector<int>& seats) const;
+    
+    
+    int findFreeRun(int row, int length) const;
     
     
     
@@ -61,19 +78,32 @@ public:
     
     
     std::vector<AABB> getPlatformBounds() const;
+    const std::vector<StepPlatform>& getPlatforms() const { return m_platforms; }
+    glm::vec3 getPlatformColor() const { return glm::vec3(0.35f, 0.3f, 0.25f); }
     
 private:
-    Seat m_seats[ROWS][COLS];
+    SeatLayout m_layout;
+    
+    
+    std::vector<glm::vec3> m_seatPositions;
+    std::vector<AABB> m_seatBounds;
+    std::vector<SeatState> m_seatStates;
+    std::vector<int> m_seatSections;
+    
     std::vector<StepPlatform> m_platforms;  
-    DebugCube* m_cubeMesh;  
-    SeatMesh* m_seatMesh;   
     
-    glm::vec3 m_origin;
-    float m_seatSpacingX;
-    float m_seatSpacingZ;
-    float m_rowElevationStep;
     glm::vec3 m_seatHalfExtents;  
     
+    unsigned int m_layoutVersion;
+    unsigned int m_stateVersion;
+    
+    
+    int m_wordsPerRow;
+    std::vector<uint64_t> m_freeBits;
+    std::vector<int> m_rowFreeCounts;
+    int m_stateCounts[3];
+    
     void createPlatforms();
     void createSeats();
+    void rebuildOccupancy();
 };
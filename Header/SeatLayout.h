@@ -0,0 +1,32 @@
+﻿#pragma once
+
+#include <glm/glm.hpp>
+#include <string>
+#include <vector>
+
+struct SeatLayout
+{
+    int rows;
+    int cols;
+    
+    
+    std::vector<int> aisleColumns;
+    float aisleWidth;
+    
+    glm::vec3 origin;
+    float seatSpacingX;
+    float seatSpacingZ;
+    float rowElevationStep;
+    
+    SeatLayout();
+    
+    
+    static bool loadFromFile(const std::string& path, SeatLayout& layout);
+    
+    bool isValid() const;
+    int seatCount() const { return rows * cols; }
+    int sectionCount() const { return (int)aisleColumns.size() + 1; }
+    int sectionOfColumn(int col) const;
+    float totalAisleWidth() const { return aisleWidth * (float)aisleColumns.size(); }
+    float aisleOffsetForColumn(int col) const;
+};
@@ -13,9 +13,18 @@ public:
     void draw() const;
     void cleanup();
 
+    void bindVertexAttributes() const;
+    int getVertexCount() const { return m_vertexCount; }
+    int getIndexCount() const { return m_indexCount; }
+
 private:
+    void uploadMesh(const float* vertices, int vertexCount,
+                    const unsigned int* indices, int indexCount);
+
     GLuint m_VAO;
     GLuint m_VBO;
+    GLuint m_EBO;
     int    m_vertexCount;
+    int    m_indexCount;
     bool   m_initialized;
 };
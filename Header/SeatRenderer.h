@@ -0,0 +1,60 @@
+﻿#pragma once
+
+#include "Seat.h"
+#include <glm/glm.hpp>
+#include <vector>
+
+class SeatGrid;
+class Shader;
+class DebugCube;
+class SeatMesh;
+
+struct SeatInstance
+{
+    glm::mat4 model;
+    glm::vec4 color;
+};
+
+class SeatRenderer
+{
+public:
+    SeatRenderer();
+    ~SeatRenderer();
+    
+    void init(DebugCube* cubeMesh, SeatMesh* seatMesh);
+    void cleanup();
+    
+    void draw(const SeatGrid& grid, Shader* phongShader);
+    
+    
+    void setInstancedShader(Shader* shader) { m_instancedShader = shader; }
+    void setInstancingEnabled(bool enabled) { m_instancingEnabled = enabled; }
+    bool isInstancingEnabled() const { return m_instancingEnabled; }
+    
+private:
+    DebugCube* m_cubeMesh;  
+    SeatMesh* m_seatMesh;   
+    
+    
+    Shader* m_instancedShader;
+    bool m_instancingEnabled;
+    bool m_instanceBuffersCreated;
+    bool m_seatInstancesDirty;
+    unsigned int m_seatInstanceVAO;
+    unsigned int m_seatInstanceVBO;
+    std::vector<SeatInstance> m_seatInstances;
+    
+    
+    bool m_synced;
+    unsigned int m_layoutVersion;
+    unsigned int m_stateVersion;
+    
+    void syncInstances(const SeatGrid& grid);
+    void drawInstanced();
+    void createInstanceBuffers();
+    void releaseInstanceBuffers();
+    void setupInstanceAttributes() const;
+    
+    static glm::mat4 seatModelMatrix(const glm::vec3& position, const glm::vec3& halfExtents);
+    static glm::vec3 stateColor(SeatState state);
+};
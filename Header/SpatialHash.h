@@ -0,0 +1,81 @@
+﻿#pragma once
+
+#include <glm/glm.hpp>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+class SpatialHash
+{
+public:
+    SpatialHash();
+
+    void setCellSize(float cellSize);
+    float getCellSize() const { return m_cellSize; }
+
+    void build(const std::vector<glm::vec3>& positions, const std::vector<int>& indices);
+    void clear();
+
+    bool empty() const { return m_entries.empty(); }
+
+    template <typename Visitor>
+    void forEachNear(const std::vector<glm::vec3>& positions, const glm::vec3& point, float radius, Visitor visit) const
+    {
+        if (m_entries.empty())
+            return;
+
+        float radiusSq = radius * radius;
+        int minX = cellCoord(point.x - radius);
+        int maxX = cellCoord(point.x + radius);
+        int minZ = cellCoord(point.z - radius);
+        int maxZ = cellCoord(point.z + radius);
+
+        uint32_t visited[MAX_QUERY_CELLS];
+        int visitedCount = 0;
+
+        for (int cz = minZ; cz <= maxZ; ++cz)
+        {
+            for (int cx = minX; cx <= maxX; ++cx)
+            {
+                uint32_t bucket = bucketOf(cx, cz);
+                bool seen = false;
+                for (int v = 0; v < visitedCount; ++v)
+                    seen = seen || visited[v] == bucket;
+                if (seen)
+                    continue;
+                if (visitedCount < MAX_QUERY_CELLS)
+                    visited[visitedCount++] = bucket;
+
+                for (uint32_t e = m_bucketStart[bucket]; e < m_bucketStart[bucket + 1]; ++e)
+                {
+                    int index = m_entries[e];
+                    glm::vec3 offset = positions[index] - point;
+                    if (offset.x * offset.x + offset.z * offset.z <= radiusSq)
+                        visit(index);
+                }
+            }
+        }
+    }
+
+private:
+    static constexpr int MAX_QUERY_CELLS = 9;
+
+    float m_cellSize;
+    float m_inverseCellSize;
+    uint32_t m_bucketMask;
+
+    std::vector<uint32_t> m_bucketStart;
+    std::vector<uint32_t> m_entryBuckets;
+    std::vector<uint32_t> m_cursor;
+    std::vector<int> m_entries;
+
+    int cellCoord(float value) const
+    {
+        return (int)std::floor(value * m_inverseCellSize);
+    }
+
+    uint32_t bucketOf(int cellX, int cellZ) const
+    {
+        return ((uint32_t)cellX * 73856093u ^ (uint32_t)cellZ * 19349663u) & m_bucketMask;
+    }
+};
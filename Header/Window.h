@@ -19,11 +19,15 @@ public:
 
     void pollEvents();
     void swapBuffers();
+    
+    void setVSync(bool enabled);
+    int refreshRate() const { return m_refreshRate; }
 
 private:
     GLFWwindow* m_window;
     int m_width;
     int m_height;
+    int m_refreshRate;
 
     static void keyCallback(GLFWwindow* window, int key, int scancode, int action, int mods);
 };
@@ -1,5 +1,6 @@
 ﻿#include "Shader.h"
 #include <iostream>
+#include <cstring>
 
 Shader::Shader(const char* vertexPath, const char* fragmentPath)
 {
@@ -90,4 +91,63 @@ Shader::Shader(const char* vertexPath, const char* fragmentPath)
 
     glDeleteShader(vertex);
     glDeleteShader(fragment);
+
+    if (success)
+    {
+        reflectUniforms();
+        bindUniformBlock("FrameData", FRAME_DATA_BINDING);
+    }
+}
+
+void Shader::reflectUniforms()
+{
+    m_uniforms.clear();
+
+    GLint uniformCount = 0;
+    GLint maxNameLength = 0;
+    glGetProgramiv(ID, GL_ACTIVE_UNIFORMS, &uniformCount);
+    glGetProgramiv(ID, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxNameLength);
+
+    std::vector<char> nameBuffer(maxNameLength > 0 ? maxNameLength : 1);
+    m_uniforms.reserve(uniformCount);
+
+    for (GLint i = 0; i < uniformCount; ++i)
+    {
+        GLsizei length = 0;
+        GLint size = 0;
+        GLenum type = 0;
+        glGetActiveUniform(ID, (GLuint)i, (GLsizei)nameBuffer.size(), &length, &size, &type, nameBuffer.data());
+
+        std::string name(nameBuffer.data(), length);
+        GLint location = glGetUniformLocation(ID, name.c_str());
+        if (location < 0)
+            continue;
+
+        
+        size_t bracket = name.find('[');
+        if (bracket != std::string::npos)
+            name.erase(bracket);
+
+        m_uniforms.push_back(UniformEntry{ name, location });
+    }
+}
+
+GLint Shader::uniformLocation(const char* name) const
+{
+    for (const UniformEntry& entry : m_uniforms)
+    {
+        if (std::strcmp(entry.name.c_str(), name) == 0)
+            return entry.location;
+    }
+    return -1;
+}
+
+bool Shader::bindUniformBlock(const char* blockName, GLuint bindingPoint)
+{
+    GLuint blockIndex = glGetUniformBlockIndex(ID, blockName);
+    if (blockIndex == GL_INVALID_INDEX)
+        return false;
+
+    glUniformBlockBinding(ID, blockIndex, bindingPoint);
+    return true;
 }
@@ -3,6 +3,7 @@
 #include <glm/glm.hpp>
 #include <glm/gtc/type_ptr.hpp>
 #include <string>
+#include <vector>
 #include <fstream>
 #include <sstream>
 #include <iostream>
@@ -12,6 +13,8 @@ class Shader
 public:
     unsigned int ID;
 
+    static constexpr GLuint FRAME_DATA_BINDING = 0;
+
     Shader(const char* vertexPath, const char* fragmentPath);
 
     void use()
@@ -19,39 +22,77 @@ public:
         glUseProgram(ID);
     }
 
-    void setFloat(const std::string& name, float value)
+    GLint uniformLocation(const char* name) const;
+    bool bindUniformBlock(const char* blockName, GLuint bindingPoint);
+
+    void setFloat(GLint loc, float value)
     {
-        GLint loc = glGetUniformLocation(ID, name.c_str());
         glUniform1f(loc, value);
     }
 
-    void setInt(const std::string& name, int value)
+    void setInt(GLint loc, int value)
     {
-        GLint loc = glGetUniformLocation(ID, name.c_str());
         glUniform1i(loc, value);
     }
 
-    void setVec3(const std::string& name, float x, float y, float z)
+    void setVec3(GLint loc, float x, float y, float z)
     {
-        GLint loc = glGetUniformLocation(ID, name.c_str());
         glUniform3f(loc, x, y, z);
     }
 
-    void setVec3(const std::string& name, const glm::vec3& value)
+    void setVec3(GLint loc, const glm::vec3& value)
     {
-        GLint loc = glGetUniformLocation(ID, name.c_str());
         glUniform3fv(loc, 1, glm::value_ptr(value));
     }
 
-    void setVec4(const std::string& name, float x, float y, float z, float w)
+    void setVec4(GLint loc, float x, float y, float z, float w)
     {
-        GLint loc = glGetUniformLocation(ID, name.c_str());
         glUniform4f(loc, x, y, z, w);
     }
 
-    void setMat4(const std::string& name, const glm::mat4& mat)
+    void setMat4(GLint loc, const glm::mat4& mat)
     {
-        GLint loc = glGetUniformLocation(ID, name.c_str());
         glUniformMatrix4fv(loc, 1, GL_FALSE, glm::value_ptr(mat));
     }
+
+    void setFloat(const char* name, float value)
+    {
+        setFloat(uniformLocation(name), value);
+    }
+
+    void setInt(const char* name, int value)
+    {
+        setInt(uniformLocation(name), value);
+    }
+
+    void setVec3(const char* name, float x, float y, float z)
+    {
+        setVec3(uniformLocation(name), x, y, z);
+    }
+
+    void setVec3(const char* name, const glm::vec3& value)
+    {
+        setVec3(uniformLocation(name), value);
+    }
+
+    void setVec4(const char* name, float x, float y, float z, float w)
+    {
+        setVec4(uniformLocation(name), x, y, z, w);
+    }
+
+    void setMat4(const char* name, const glm::mat4& mat)
+    {
+        setMat4(uniformLocation(name), mat);
+    }
+
+private:
+    struct UniformEntry
+    {
+        std::string name;
+        GLint location;
+    };
+
+    std::vector<UniformEntry> m_uniforms;
+
+    void reflectUniforms();
 };
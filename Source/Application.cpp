@@ -1,5 +1,17 @@
 ﻿#include "../Header/Application.h"
 #include "../Header/Log.h"
+#include "../Header/Scene.h"
+#include "../Header/SeatGrid.h"
+#include "../Header/SeatLayout.h"
+#include "../Header/BookingEngine.h"
+#include "../Header/PeopleManager.h"
+#include "../Header/Screen.h"
+#include "../Header/Door.h"
+#include "../Header/AABB.h"
+#include "../Header/JobSystem.h"
+#include "../Header/HallNavigation.h"
+#include "../Header/Profiler.h"
+#ifndef KOSTUR_HEADLESS_ONLY
 #include "../Header/AppTime.h"
 #include "../Header/Window.h"
 #include "../Header/FrameLimiter.h"
@@ -8,28 +20,47 @@
 #include "../Header/DebugCube.h"
 #include "../Header/SeatMesh.h"
 #include "../Header/HumanMesh.h"
-#include "../Header/Scene.h"
-#include "../Header/SeatGrid.h"
+#include "../Header/SeatRenderer.h"
 #include "../Header/RayPicker.h"
 #include "../Header/Crosshair.h"
-#include "../Header/PeopleManager.h"
-#include "../Header/Screen.h"
-#include "../Header/Door.h"
 #include "../Header/HUD.h"
-#include "../Header/AABB.h"
+#include "../Header/FrameUniforms.h"
+#include "../Header/GpuProfiler.h"
 #include "../Shader.h"
 #include <GL/glew.h>
 #include <GLFW/glfw3.h>
+#endif
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <random>
+
+static const char* SEAT_LAYOUT_PATH = "Assets/Layouts/hall.layout";
+static const glm::vec3 DOOR_ENTRY_OFFSET(0.4f, -0.05f, 0.0f);
+
+static SeatLayout loadSeatLayout()
+{
+    SeatLayout layout;
+    if (!SeatLayout::loadFromFile(SEAT_LAYOUT_PATH, layout))
+    {
+        LOG_WARNING("Using built-in seat layout");
+    }
+    return layout;
+}
 
 Application::Application()
     : m_running(false)
     , m_currentState(AppState::Booking)
     , m_stateTimer(0.0f)
     , m_debugPrintTimer(0.0f)
+    , m_holdExpiryTimer(0.0f)
     , m_depthTestEnabled(true)
     , m_cullingEnabled(false)
+    , m_simulationAccumulator(0.0)
+    , m_doorEntryPosition(0.0f)
+#ifndef KOSTUR_HEADLESS_ONLY
     , m_window(nullptr)
     , m_frameLimiter(nullptr)
     , m_camera(nullptr)
@@ -39,14 +70,25 @@ Application::Application()
     , m_basicShader(nullptr)
     , m_phongShader(nullptr)
     , m_humanShader(nullptr)
-    , m_scene(nullptr)
-    , m_seatGrid(nullptr)
+    , m_crowdShader(nullptr)
+    , m_instancedShader(nullptr)
+    , m_staticShader(nullptr)
+    , m_frameUniforms(nullptr)
+    , m_seatRenderer(nullptr)
     , m_rayPicker(nullptr)
     , m_crosshair(nullptr)
+    , m_hud(nullptr)
+    , m_gpuProfiler(nullptr)
+#endif
+    , m_scene(nullptr)
+    , m_seatGrid(nullptr)
+    , m_bookingEngine(nullptr)
+    , m_pickerSession(0)
     , m_peopleManager(nullptr)
     , m_screen(nullptr)
     , m_door(nullptr)
-    , m_hud(nullptr)
+    , m_jobSystem(nullptr)
+    , m_navigation(nullptr)
 {
 }
 
@@ -54,7 +96,8 @@ Application::~Application()
 {
 }
 
-bool Application::init()
+#ifndef KOSTUR_HEADLESS_ONLY
+bool Application::init(bool vsync)
 {
     LOG_INFO("Initializing Application...");
     
@@ -71,18 +114,17 @@ bool Application::init()
     Input::init(m_window->handle());
     
     m_frameLimiter = std::unique_ptr<FrameLimiter>(new FrameLimiter(75.0));
+    if (vsync)
+    {
+        m_window->setVSync(true);
+        m_frameLimiter->setVSync(true, m_window->refreshRate());
+    }
     
     m_camera = std::unique_ptr<Camera>(new Camera(
         glm::vec3(0.0f, 1.7f, 8.0f),
         -90.0f,
         0.0f
     ));
-    
-    AABB hallBounds(
-        glm::vec3(-9.0f, 0.5f, -9.0f),
-        glm::vec3(9.0f, 5.0f, 9.0f)
-    );
-    m_camera->setBounds(hallBounds);
     m_camera->setBoundsPadding(0.3f);
     
     m_debugCube = std::unique_ptr<DebugCube>(new DebugCube());
@@ -128,13 +170,52 @@ bool Application::init()
         m_humanShader.reset();
     }
     
+    m_crowdShader = std::unique_ptr<Shader>(new Shader(
+        "Assets/Shaders/human_instanced.vert",
+        "Assets/Shaders/human.frag"
+    ));
+    
+    if (m_crowdShader->ID == 0)
+    {
+        LOG_ERROR("Failed to create crowd shader, falling back to per-person draws");
+        m_crowdShader.reset();
+    }
+    
+    m_instancedShader = std::unique_ptr<Shader>(new Shader(
+        "Assets/Shaders/phong_instanced.vert",
+        "Assets/Shaders/phong_vertexcolor.frag"
+    ));
+    
+    if (m_instancedShader->ID == 0)
+    {
+        LOG_ERROR("Failed to create instanced shader, falling back to per-seat draws");
+        m_instancedShader.reset();
+    }
+    
+    m_staticShader = std::unique_ptr<Shader>(new Shader(
+        "Assets/Shaders/phong_static.vert",
+        "Assets/Shaders/phong_vertexcolor.frag"
+    ));
+    
+    if (m_staticShader->ID == 0)
+    {
+        LOG_ERROR("Failed to create static geometry shader, falling back to per-object draws");
+        m_staticShader.reset();
+    }
+    
+    m_frameUniforms = std::unique_ptr<FrameUniforms>(new FrameUniforms());
+    m_frameUniforms->init();
+    
+    m_gpuProfiler = std::unique_ptr<GpuProfiler>(new GpuProfiler());
+    m_gpuProfiler->init();
+    
     m_humanMesh = std::unique_ptr<HumanMesh>(new HumanMesh());
     if (!m_humanMesh->loadOBJ("Assets/Models/human1.obj"))
     {
         LOG_ERROR("Failed to load human mesh, falling back to cubes");
         m_humanMesh.reset();
     }
-    else if (!m_humanMesh->loadMultipleTextures("Assets/Textures", 10))
+    else if (!m_humanMesh->loadTextureArray("Assets/Textures", 10, HUMAN_TEXTURE_LAYER_SIZE))
     {
         LOG_ERROR("Failed to load human textures, falling back to cubes");
         m_humanMesh.reset();
@@ -152,12 +233,28 @@ bool Application::init()
     
     LOG_INFO("[RENDER] Initial state: DepthTest=ON Culling=OFF");
     
+    SeatLayout seatLayout = loadSeatLayout();
+    
     m_scene = std::unique_ptr<Scene>(new Scene());
-    m_scene->init(m_debugCube.get());
+    m_scene->init(m_debugCube.get(), seatLayout);
+    m_scene->setStaticShader(m_staticShader.get());
+    
+    
+    const AABB& hallBounds = m_scene->getHallBounds();
+    m_camera->setBounds(hallBounds);
+    m_camera->setPosition(glm::vec3((hallBounds.min.x + hallBounds.max.x) * 0.5f, 1.7f, hallBounds.max.z - 1.0f));
     
     m_seatGrid = std::unique_ptr<SeatGrid>(new SeatGrid());
-    glm::vec3 seatOrigin(0.0f, 1.0f, 2.0f);
-    m_seatGrid->init(m_debugCube.get(), m_seatMesh.get(), seatOrigin, 1.0f, 1.2f, 0.3f);
+    m_seatGrid->init(seatLayout);
+    
+    m_seatRenderer = std::unique_ptr<SeatRenderer>(new SeatRenderer());
+    m_seatRenderer->init(m_debugCube.get(), m_seatMesh.get());
+    m_seatRenderer->setInstancedShader(m_instancedShader.get());
+    
+    for (const StepPlatform& platform : m_seatGrid->getPlatforms())
+    {
+        m_scene->addStaticObject(SceneObject(platform.position, platform.size, m_seatGrid->getPlatformColor()));
+    }
     
     std::vector<AABB> platformBounds = m_seatGrid->getPlatformBounds();
     std::vector<AABB> sceneBounds = m_scene->getCollidableBounds();
@@ -167,21 +264,24 @@ bool Application::init()
     m_camera->setAdditionalBounds(allBounds);
     
     m_rayPicker = std::unique_ptr<RayPicker>(new RayPicker());
+    m_rayPicker->buildScene(*m_seatGrid, m_scene->getOccluderBounds());
     
     m_crosshair = std::unique_ptr<Crosshair>(new Crosshair());
     m_crosshair->init();
     
-    m_peopleManager = std::unique_ptr<PeopleManager>(new PeopleManager());
+    createSimulation(allBounds);
+    
     if (m_humanMesh && m_humanShader)
     {
         m_peopleManager->setHumanMesh(m_humanMesh.get());
         m_peopleManager->setHumanShader(m_humanShader.get());
+        m_peopleManager->setCrowdShader(m_crowdShader.get());
     }
     
     m_screen = std::unique_ptr<Screen>(new Screen());
+    m_screen->setPosition(m_scene->getScreenPosition());
     m_screen->init();
     
-    m_door = std::unique_ptr<Door>(new Door());
     m_door->init(m_debugCube.get());
     
     m_hud = std::unique_ptr<HUD>(new HUD());
@@ -196,7 +296,146 @@ bool Application::init()
     
     return true;
 }
+#endif
+
+void Application::createSimulation(const std::vector<AABB>& walkableBounds)
+{
+    m_bookingEngine = std::unique_ptr<BookingEngine>(new BookingEngine());
+    m_bookingEngine->init(*m_seatGrid);
+    m_pickerSession = m_bookingEngine->createSession();
+    
+    m_jobSystem = std::unique_ptr<JobSystem>(new JobSystem());
+    m_jobSystem->init();
+    
+    m_doorEntryPosition = m_scene->getDoorPosition() + DOOR_ENTRY_OFFSET;
+    
+    m_navigation = std::unique_ptr<HallNavigation>(new HallNavigation());
+    if (!m_navigation->build(m_scene->getFloorBounds(), m_seatGrid->getLayout(),
+                             m_seatGrid->getSeatPositions(), m_seatGrid->getSeatBounds(),
+                             walkableBounds, m_doorEntryPosition))
+    {
+        LOG_WARNING("Navigation unavailable - people will walk straight to their seats");
+    }
+    
+    m_peopleManager = std::unique_ptr<PeopleManager>(new PeopleManager());
+    m_peopleManager->setJobSystem(m_jobSystem.get());
+    m_peopleManager->setNavigation(m_navigation.get());
+    
+    m_door = std::unique_ptr<Door>(new Door());
+    m_door->setPosition(m_scene->getDoorPosition());
+}
 
+bool Application::initHeadless(const HeadlessOptions& options)
+{
+    LOG_INFO("Initializing Application (headless)...");
+    
+    Log::init();
+    m_headlessOptions = options;
+    
+    SeatLayout seatLayout = loadSeatLayout();
+    
+    m_scene = std::unique_ptr<Scene>(new Scene());
+    m_scene->init(nullptr, seatLayout);
+    
+    m_seatGrid = std::unique_ptr<SeatGrid>(new SeatGrid());
+    m_seatGrid->init(seatLayout);
+    
+    std::vector<AABB> platformBounds = m_seatGrid->getPlatformBounds();
+    std::vector<AABB> sceneBounds = m_scene->getCollidableBounds();
+    std::vector<AABB> allBounds;
+    allBounds.insert(allBounds.end(), platformBounds.begin(), platformBounds.end());
+    allBounds.insert(allBounds.end(), sceneBounds.begin(), sceneBounds.end());
+    
+    createSimulation(allBounds);
+    
+    m_screen = std::unique_ptr<Screen>(new Screen());
+    m_screen->initHeadless();
+    
+    m_door->init(nullptr);
+    
+    enterState(AppState::Booking);
+    
+    m_running = true;
+    LOG_INFO("Headless application initialized");
+    
+    return true;
+}
+
+int Application::runHeadless()
+{
+    const HeadlessOptions& options = m_headlessOptions;
+    LOG_INFO("[HEADLESS] Running " + std::to_string(options.cycles) + " cycles with " +
+             std::to_string(options.seatsPerCycle) + " seats at dt=" + std::to_string(options.timeStep) + "s");
+    
+    std::chrono::steady_clock::time_point wallStart = std::chrono::steady_clock::now();
+    double simulatedSeconds = 0.0;
+    long long steps = 0;
+    int completedCycles = 0;
+    AppState previousState = m_currentState;
+    
+    while (m_running && completedCycles < options.cycles && simulatedSeconds < options.maxSimulatedSeconds)
+    {
+        if (m_currentState == AppState::Booking)
+        {
+            bookHeadlessSeats();
+            enterState(AppState::Entering);
+        }
+        
+        Profiler::beginFrame();
+        simulationStep(options.timeStep);
+        Profiler::endFrame();
+        simulatedSeconds += options.timeStep;
+        ++steps;
+        
+        if (previousState == AppState::Reset && m_currentState == AppState::Booking)
+        {
+            ++completedCycles;
+            LOG_INFO("[HEADLESS] Cycle " + std::to_string(completedCycles) + " complete at t=" +
+                     std::to_string(simulatedSeconds) + "s");
+        }
+        previousState = m_currentState;
+    }
+    
+    double wallSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - wallStart).count();
+    double speedup = wallSeconds > 0.0 ? simulatedSeconds / wallSeconds : 0.0;
+    LOG_INFO("[HEADLESS] " + std::to_string(completedCycles) + "/" + std::to_string(options.cycles) +
+             " cycles, " + std::to_string(steps) + " steps, simulated " + std::to_string(simulatedSeconds) +
+             "s in " + std::to_string(wallSeconds) + "s wall (" + std::to_string(speedup) + "x real time)");
+    Profiler::logStats();
+    
+    if (completedCycles < options.cycles)
+    {
+        LOG_ERROR("[HEADLESS] Stopped after " + std::to_string(options.maxSimulatedSeconds) +
+                  "s simulated in state " + std::string(stateToString(m_currentState)));
+        return 1;
+    }
+    return 0;
+}
+
+void Application::bookHeadlessSeats()
+{
+    static std::mt19937 rng(12345u);
+    
+    std::vector<int> freeSeats;
+    for (int i = 0; i < m_seatGrid->getSeatCount(); ++i)
+    {
+        if (m_seatGrid->getSeatState(i) == SeatState::Free)
+            freeSeats.push_back(i);
+    }
+    std::shuffle(freeSeats.begin(), freeSeats.end(), rng);
+    
+    int target = std::min(m_headlessOptions.seatsPerCycle, (int)freeSeats.size());
+    int count = 0;
+    for (int i = 0; i < target; ++i)
+    {
+        if (m_bookingEngine->hold(m_pickerSession, &freeSeats[i], 1, BookingEngine::NO_EXPIRY))
+            ++count;
+    }
+    m_bookingEngine->syncTo(*m_seatGrid);
+    LOG_INFO("[HEADLESS] Reserved " + std::to_string(count) + " seats");
+}
+
+#ifndef KOSTUR_HEADLESS_ONLY
 void Application::run()
 {
     LOG_INFO("Starting main loop...");
@@ -204,46 +443,50 @@ void Application::run()
     while (m_running && !m_window->shouldClose())
     {
         m_frameLimiter->beginFrame();
-        m_window->pollEvents();
-        Input::update();
-        Time::update();
-        
-        float dt = Time::deltaTime();
+        Profiler::beginFrame();
+        m_gpuProfiler->beginFrame();
         
-        
-        updateStateMachine(dt);
-        
-        
-        if (m_currentState == AppState::Booking)
+        float dt;
         {
-            handleSeatPicking();
-            handlePurchaseKeys();
+            PROFILE_ZONE("Input");
+            m_window->pollEvents();
+            Input::update();
+            Time::update();
+            
+            dt = Time::deltaTime();
+            
+            
+            if (m_currentState == AppState::Booking)
+            {
+                handleSeatPicking();
+                handlePurchaseKeys();
+            }
+            handleEnterKey();
+            
+            
+            handleRenderToggles();
         }
-        handleEnterKey();
-        
-        
-        handleRenderToggles();
-        
         
-        m_camera->update(dt);
-        
-        
-        if (m_door)
         {
-            m_door->update(dt);
+            PROFILE_ZONE("Camera::update");
+            m_camera->update(dt);
         }
         
         
-        if (m_peopleManager)
+        m_simulationAccumulator += dt;
+        int steps = 0;
+        while (m_simulationAccumulator >= SIMULATION_STEP && steps < MAX_SIMULATION_STEPS)
         {
-            m_peopleManager->update(dt);
+            PROFILE_ZONE("Simulation");
+            simulationStep(SIMULATION_STEP);
+            m_simulationAccumulator -= SIMULATION_STEP;
+            ++steps;
         }
-        
-        
-        if (m_screen)
+        if (m_simulationAccumulator >= SIMULATION_STEP)
         {
-            m_screen->update(dt);
+            m_simulationAccumulator = std::fmod(m_simulationAccumulator, (double)SIMULATION_STEP);
         }
+        float interpolation = static_cast<float>(m_simulationAccumulator / SIMULATION_STEP);
         
         
         m_debugPrintTimer += dt;
@@ -253,17 +496,18 @@ void Application::run()
             int occupied = countOccupiedSeats();
             int people = m_peopleManager ? m_peopleManager->getPeopleCount() : 0;
             bool playing = m_screen ? m_screen->isPlaying() : false;
-            LOG_INFO("[STATE] " + std::string(stateToString(m_currentState)) + 
-                     " | occupied=" + std::to_string(occupied) +
-                     " people=" + std::to_string(people) +
-                     " playing=" + std::to_string(playing) +
-                     " | Depth=" + std::string(m_depthTestEnabled ? "ON" : "OFF") +
-                     " Cull=" + std::string(m_cullingEnabled ? "ON" : "OFF"));
+            LOG_INFOF("[STATE] %s | occupied=%d people=%d playing=%d fps=%ld | Depth=%s Cull=%s",
+                      stateToString(m_currentState), occupied, people, (int)playing,
+                      std::lround(m_frameLimiter->getCurrentFPS()),
+                      m_depthTestEnabled ? "ON" : "OFF", m_cullingEnabled ? "ON" : "OFF");
         }
         
         
-        glClearColor(0.1f, 0.1f, 0.15f, 1.0f);
-        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+        {
+            PROFILE_GPU_ZONE(m_gpuProfiler.get(), "Clear");
+            glClearColor(0.1f, 0.1f, 0.15f, 1.0f);
+            glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+        }
         
         float aspect = static_cast<float>(m_window->width()) / static_cast<float>(m_window->height());
         glm::mat4 view = m_camera->viewMatrix();
@@ -271,39 +515,103 @@ void Application::run()
         glm::vec3 viewPos = m_camera->getPosition();
         
         m_scene->update(dt);
-        m_scene->draw(view, projection, m_phongShader.get(), m_basicShader.get(), viewPos);
+        m_frameUniforms->update(view, projection, m_scene->getActiveLight(), viewPos);
         
-        if (m_door)
         {
-            m_door->draw(m_phongShader.get(), view, projection, viewPos);
+            PROFILE_GPU_ZONE(m_gpuProfiler.get(), "Scene::draw");
+            m_scene->draw(m_phongShader.get(), m_basicShader.get());
+            
+            if (m_door)
+            {
+                m_door->draw(m_phongShader.get(), interpolation);
+            }
         }
         
-        m_seatGrid->draw(m_phongShader.get(), view, projection, viewPos);
+        {
+            PROFILE_GPU_ZONE(m_gpuProfiler.get(), "SeatGrid::draw");
+            m_seatRenderer->draw(*m_seatGrid, m_phongShader.get());
+        }
         
         if (m_peopleManager)
         {
-            m_peopleManager->draw(*m_phongShader, view, projection, viewPos, *m_debugCube);
+            PROFILE_GPU_ZONE(m_gpuProfiler.get(), "PeopleManager::draw");
+            m_peopleManager->draw(*m_phongShader, *m_debugCube, interpolation);
         }
         
         if (m_screen)
         {
-            m_screen->draw(view, projection);
+            {
+                PROFILE_ZONE("Screen::uploadPendingFrames");
+                m_screen->uploadPendingFrames();
+            }
+            
+            PROFILE_GPU_ZONE(m_gpuProfiler.get(), "Screen::draw");
+            m_screen->draw();
         }
         
-        m_crosshair->draw(m_basicShader.get(), m_window->width(), m_window->height());
-        
+        {
+            PROFILE_GPU_ZONE(m_gpuProfiler.get(), "HUD");
+            m_crosshair->draw(m_basicShader.get(), m_window->width(), m_window->height());
+            
+            
+            if (m_hud)
+            {
+                m_hud->draw();
+            }
+        }
         
-        if (m_hud)
         {
-            m_hud->draw();
+            PROFILE_ZONE("SwapBuffers");
+            m_window->swapBuffers();
         }
         
-        m_window->swapBuffers();
-        m_frameLimiter->endFrame();
+        {
+            PROFILE_ZONE("FrameLimiter");
+            m_frameLimiter->endFrame();
+        }
+        Profiler::endFrame();
     }
     
     LOG_INFO("Main loop ended");
 }
+#endif
+
+void Application::simulationStep(float deltaTime)
+{
+    
+    m_holdExpiryTimer += deltaTime;
+    if (m_holdExpiryTimer >= HOLD_EXPIRY_INTERVAL)
+    {
+        m_holdExpiryTimer = 0.0f;
+        m_bookingEngine->expireHolds();
+    }
+    m_bookingEngine->syncTo(*m_seatGrid);
+    
+    {
+        PROFILE_ZONE("StateMachine");
+        updateStateMachine(deltaTime);
+    }
+    
+    
+    if (m_door)
+    {
+        m_door->update(deltaTime);
+    }
+    
+    
+    if (m_peopleManager)
+    {
+        PROFILE_ZONE("PeopleManager::update");
+        m_peopleManager->update(deltaTime);
+    }
+    
+    
+    if (m_screen)
+    {
+        PROFILE_ZONE("Screen::update");
+        m_screen->update(deltaTime);
+    }
+}
 
 void Application::updateStateMachine(float deltaTime)
 {
@@ -396,8 +704,7 @@ void Application::updateEnteringState()
         int occupied = countOccupiedSeats();
         if (occupied > 0 && m_peopleManager && m_seatGrid)
         {
-            glm::vec3 doorPos(-8.5f, 1.7f, -5.0f);  
-            m_peopleManager->spawnPeopleRandom(*m_seatGrid, doorPos, 1, occupied);
+            m_peopleManager->spawnPeopleRandom(*m_seatGrid, m_doorEntryPosition, 1, occupied);
             LOG_INFO("Door fully open - spawned " + std::to_string(m_peopleManager->getPeopleCount()) + 
                      " people for " + std::to_string(occupied) + " occupied seats");
         }
@@ -475,16 +782,10 @@ void Application::updateResetState()
     if (m_peopleManager) m_peopleManager->clear();
     
     
-    if (m_seatGrid)
+    if (m_bookingEngine)
     {
-        for (int row = 0; row < SeatGrid::ROWS; ++row)
-        {
-            for (int col = 0; col < SeatGrid::COLS; ++col)
-            {
-                Seat* seat = m_seatGrid->getSeat(row, col);
-                if (seat) seat->state = SeatState::Free;
-            }
-        }
+        m_bookingEngine->reset();
+        m_bookingEngine->syncTo(*m_seatGrid);
     }
     
     
@@ -515,6 +816,7 @@ void Application::setLightingForState(AppState state)
     }
 }
 
+#ifndef KOSTUR_HEADLESS_ONLY
 void Application::handleEnterKey()
 {
     if (Input::isKeyPressed(GLFW_KEY_ENTER))
@@ -535,24 +837,13 @@ void Application::handleEnterKey()
         }
     }
 }
+#endif
 
 int Application::countOccupiedSeats() const
 {
     if (!m_seatGrid) return 0;
     
-    int count = 0;
-    for (int row = 0; row < SeatGrid::ROWS; ++row)
-    {
-        for (int col = 0; col < SeatGrid::COLS; ++col)
-        {
-            Seat* seat = m_seatGrid->getSeat(row, col);
-            if (seat && (seat->state == SeatState::Reserved || seat->state == SeatState::Purchased))
-            {
-                count++;
-            }
-        }
-    }
-    return count;
+    return m_seatGrid->countOccupiedSeats();
 }
 
 const char* Application::stateToString(AppState state) const
@@ -568,6 +859,7 @@ const char* Application::stateToString(AppState state) const
     }
 }
 
+#ifndef KOSTUR_HEADLESS_ONLY
 void Application::handlePurchaseKeys()
 {
     for (int key = GLFW_KEY_1; key <= GLFW_KEY_9; ++key)
@@ -575,7 +867,8 @@ void Application::handlePurchaseKeys()
         if (Input::isKeyPressed(key))
         {
             int groupSize = key - GLFW_KEY_0;
-            bool success = m_seatGrid->purchaseAdjacent(groupSize);
+            bool success = m_bookingEngine->purchaseAdjacent(m_pickerSession, groupSize);
+            m_bookingEngine->syncTo(*m_seatGrid);
             
             if (success)
             {
@@ -608,22 +901,34 @@ void Application::handleSeatPicking()
     Ray ray = m_rayPicker->screenPointToRay(mouseX, mouseY, screenWidth, screenHeight, 
                                              view, projection, camPos);
     
-    Seat* pickedSeat = m_rayPicker->pickSeat(ray, *m_seatGrid);
     
-    if (pickedSeat)
+    m_peopleManager->getBounds(m_pickBounds);
+    m_rayPicker->updatePeople(m_pickBounds);
+    m_rayPicker->setDoorBounds(m_door->getBounds());
+    
+    int pickedSeat = m_rayPicker->pickSeatOccluded(ray);
+    
+    if (pickedSeat >= 0)
     {
-        if (pickedSeat->state == SeatState::Free)
+        int row = m_seatGrid->seatRow(pickedSeat);
+        int col = m_seatGrid->seatCol(pickedSeat);
+        SeatState state = m_seatGrid->getSeatState(pickedSeat);
+        
+        if (state == SeatState::Free)
         {
-            pickedSeat->state = SeatState::Reserved;
-            LOG_INFO("Seat [" + std::to_string(pickedSeat->row) + "," + 
-                     std::to_string(pickedSeat->col) + "] -> Reserved");
+            if (m_bookingEngine->hold(m_pickerSession, &pickedSeat, 1, BookingEngine::NO_EXPIRY))
+                LOG_INFOF("Seat [%d,%d] -> Reserved", row, col);
+            else
+                LOG_INFOF("Seat [%d,%d] was just taken by another booking", row, col);
         }
-        else if (pickedSeat->state == SeatState::Reserved)
+        else if (state == SeatState::Reserved)
         {
-            pickedSeat->state = SeatState::Free;
-            LOG_INFO("Seat [" + std::to_string(pickedSeat->row) + "," + 
-                     std::to_string(pickedSeat->col) + "] -> Free");
+            if (m_bookingEngine->release(m_pickerSession, &pickedSeat, 1))
+                LOG_INFOF("Seat [%d,%d] -> Free", row, col);
+            else
+                LOG_INFOF("Seat [%d,%d] is held by another booking", row, col);
         }
+        m_bookingEngine->syncTo(*m_seatGrid);
     }
 }
 
@@ -662,23 +967,47 @@ void Application::handleRenderToggles()
             LOG_INFO("[RENDER] Culling: OFF");
         }
     }
+    
+    
+    if (Input::isKeyPressed(GLFW_KEY_I) && m_seatRenderer)
+    {
+        m_seatRenderer->setInstancingEnabled(!m_seatRenderer->isInstancingEnabled());
+        LOG_INFO("[RENDER] Seat instancing: " + std::string(m_seatRenderer->isInstancingEnabled() ? "ON" : "OFF"));
+    }
+    
+    
+    if (Input::isKeyPressed(GLFW_KEY_P))
+    {
+        Profiler::startCapture("profile_trace.json", PROFILE_CAPTURE_FRAMES);
+    }
 }
+#endif
 
 void Application::shutdown()
 {
     LOG_INFO("Shutting down Application...");
     m_running = false;
     
+#ifndef KOSTUR_HEADLESS_ONLY
     if (m_hud)
     {
         m_hud->shutdown();
         m_hud.reset();
     }
+#endif
     
     m_door.reset();
     m_screen.reset();
     m_peopleManager.reset();
+    m_navigation.reset();
     
+    if (m_jobSystem)
+    {
+        m_jobSystem->shutdown();
+        m_jobSystem.reset();
+    }
+    
+#ifndef KOSTUR_HEADLESS_ONLY
     if (m_crosshair)
     {
         m_crosshair->cleanup();
@@ -686,9 +1015,17 @@ void Application::shutdown()
     }
     
     m_rayPicker.reset();
+    if (m_seatRenderer)
+    {
+        m_seatRenderer->cleanup();
+        m_seatRenderer.reset();
+    }
+#endif
+    m_bookingEngine.reset();
     m_seatGrid.reset();
     m_scene.reset();
     
+#ifndef KOSTUR_HEADLESS_ONLY
     if (m_debugCube)
     {
         m_debugCube->cleanup();
@@ -707,6 +1044,21 @@ void Application::shutdown()
         m_humanMesh.reset();
     }
     
+    if (m_gpuProfiler)
+    {
+        m_gpuProfiler->cleanup();
+        m_gpuProfiler.reset();
+    }
+    
+    if (m_frameUniforms)
+    {
+        m_frameUniforms->cleanup();
+        m_frameUniforms.reset();
+    }
+    
+    m_staticShader.reset();
+    m_instancedShader.reset();
+    m_crowdShader.reset();
     m_humanShader.reset();
     m_phongShader.reset();
     m_basicShader.reset();
@@ -719,6 +1071,7 @@ void Application::shutdown()
     }
     
     m_frameLimiter.reset();
+#endif
     
     LOG_INFO("Application shut down successfully");
 }
@@ -0,0 +1,343 @@
+﻿#include "../Header/BVH.h"
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+    float surfaceArea(const AABB& box)
+    {
+        glm::vec3 extent = box.max - box.min;
+        return 2.0f * (extent.x * extent.y + extent.y * extent.z + extent.z * extent.x);
+    }
+
+    void growBounds(AABB& box, const AABB& other)
+    {
+        box.min = glm::min(box.min, other.min);
+        box.max = glm::max(box.max, other.max);
+    }
+
+    AABB emptyBounds()
+    {
+        float big = std::numeric_limits<float>::max();
+        return AABB(glm::vec3(big), glm::vec3(-big));
+    }
+
+    
+    bool slabEntry(const AABB& box, const glm::vec3& origin, const glm::vec3& invDir, float maxDistance, float& tEntry)
+    {
+        float t1 = (box.min.x - origin.x) * invDir.x;
+        float t2 = (box.max.x - origin.x) * invDir.x;
+        float t3 = (box.min.y - origin.y) * invDir.y;
+        float t4 = (box.max.y - origin.y) * invDir.y;
+        float t5 = (box.min.z - origin.z) * invDir.z;
+        float t6 = (box.max.z - origin.z) * invDir.z;
+
+        float tmin = std::max(std::max(std::min(t1, t2), std::min(t3, t4)), std::min(t5, t6));
+        float tmax = std::min(std::min(std::max(t1, t2), std::max(t3, t4)), std::max(t5, t6));
+
+        if (tmax < 0.0f || tmin > tmax || tmin >= maxDistance)
+            return false;
+
+        tEntry = tmin;
+        return true;
+    }
+
+}
+
+BVH::BVH()
+    : m_buildPrimitives(nullptr)
+    , m_builtRootArea(0.0f)
+{
+}
+
+void BVH::build(const std::vector<AABB>& primitives)
+{
+    clear();
+    if (primitives.empty())
+        return;
+
+    int count = (int)primitives.size();
+    m_indices.resize(count);
+    m_centroids.resize(count);
+    for (int i = 0; i < count; ++i)
+    {
+        m_indices[i] = i;
+        m_centroids[i] = primitives[i].center();
+    }
+
+    
+    m_buildPrimitives = &primitives;
+    m_nodes.reserve(count * 2);
+    m_nodes.push_back(BVHNode());
+    m_nodes[0].leftFirst = 0;
+    m_nodes[0].count = count;
+    updateNodeBounds(0);
+    subdivide(0, 0);
+
+    
+    m_leafBoxes.resize(count);
+    for (int i = 0; i < count; ++i)
+        m_leafBoxes.set(i, primitives[m_indices[i]]);
+
+    m_buildPrimitives = nullptr;
+    m_centroids.clear();
+    m_centroids.shrink_to_fit();
+    m_builtRootArea = surfaceArea(m_nodes[0].bounds);
+}
+
+void BVH::refit(const std::vector<AABB>& primitives)
+{
+    if ((int)primitives.size() != getPrimitiveCount())
+    {
+        build(primitives);
+        return;
+    }
+
+    for (int i = 0; i < (int)m_indices.size(); ++i)
+        m_leafBoxes.set(i, primitives[m_indices[i]]);
+
+    
+    for (int n = (int)m_nodes.size() - 1; n >= 0; --n)
+    {
+        BVHNode& node = m_nodes[n];
+        if (node.isLeaf())
+        {
+            node.bounds = emptyBounds();
+            for (int i = 0; i < node.count; ++i)
+                growBounds(node.bounds, primitives[m_indices[node.leftFirst + i]]);
+        }
+        else
+        {
+            node.bounds = m_nodes[node.leftFirst].bounds;
+            growBounds(node.bounds, m_nodes[node.leftFirst + 1].bounds);
+        }
+    }
+}
+
+void BVH::clear()
+{
+    m_nodes.clear();
+    m_indices.clear();
+    m_leafBoxes.clear();
+    m_centroids.clear();
+    m_builtRootArea = 0.0f;
+}
+
+float BVH::getRefitGrowth() const
+{
+    if (m_nodes.empty() || m_builtRootArea <= 0.0f)
+        return 1.0f;
+    return surfaceArea(m_nodes[0].bounds) / m_builtRootArea;
+}
+
+void BVH::updateNodeBounds(int nodeIndex)
+{
+    BVHNode& node = m_nodes[nodeIndex];
+    node.bounds = emptyBounds();
+    for (int i = 0; i < node.count; ++i)
+        growBounds(node.bounds, (*m_buildPrimitives)[m_indices[node.leftFirst + i]]);
+}
+
+bool BVH::findSplit(const BVHNode& node, int& axis, int& splitBin, float& centroidMin, float& binScale) const
+{
+    glm::vec3 cmin(std::numeric_limits<float>::max());
+    glm::vec3 cmax(-std::numeric_limits<float>::max());
+    for (int i = 0; i < node.count; ++i)
+    {
+        const glm::vec3& c = m_centroids[m_indices[node.leftFirst + i]];
+        cmin = glm::min(cmin, c);
+        cmax = glm::max(cmax, c);
+    }
+
+    float nodeArea = surfaceArea(node.bounds);
+    float bestCost = node.count * nodeArea - TRAVERSAL_COST * nodeArea;
+    bool found = false;
+
+    for (int a = 0; a < 3; ++a)
+    {
+        float extent = cmax[a] - cmin[a];
+        if (extent <= 0.0f)
+            continue;
+
+        AABB binBounds[SAH_BINS];
+        int binCounts[SAH_BINS] = {};
+        for (int b = 0; b < SAH_BINS; ++b)
+            binBounds[b] = emptyBounds();
+
+        float scale = SAH_BINS / extent;
+        for (int i = 0; i < node.count; ++i)
+        {
+            int index = m_indices[node.leftFirst + i];
+            int bin = std::min(SAH_BINS - 1, (int)((m_centroids[index][a] - cmin[a]) * scale));
+            ++binCounts[bin];
+            growBounds(binBounds[bin], (*m_buildPrimitives)[index]);
+        }
+
+        
+        float leftArea[SAH_BINS - 1];
+        int leftCount[SAH_BINS - 1];
+        AABB sweep = emptyBounds();
+        int sweepCount = 0;
+        for (int b = 0; b < SAH_BINS - 1; ++b)
+        {
+            sweepCount += binCounts[b];
+            if (binCounts[b] > 0)
+                growBounds(sweep, binBounds[b]);
+            leftCount[b] = sweepCount;
+            leftArea[b] = sweepCount > 0 ? surfaceArea(sweep) : 0.0f;
+        }
+
+        sweep = emptyBounds();
+        sweepCount = 0;
+        for (int b = SAH_BINS - 1; b > 0; --b)
+        {
+            sweepCount += binCounts[b];
+            if (binCounts[b] > 0)
+                growBounds(sweep, binBounds[b]);
+            if (leftCount[b - 1] == 0 || sweepCount == 0)
+                continue;
+
+            float cost = leftCount[b - 1] * leftArea[b - 1] + sweepCount * surfaceArea(sweep);
+            if (cost < bestCost)
+            {
+                bestCost = cost;
+                axis = a;
+                splitBin = b;
+                centroidMin = cmin[a];
+                binScale = scale;
+                found = true;
+            }
+        }
+    }
+
+    return found;
+}
+
+void BVH::subdivide(int nodeIndex, int depth)
+{
+    BVHNode node = m_nodes[nodeIndex];
+    if (node.count <= 1 || depth >= MAX_DEPTH)
+        return;
+
+    int axis = 0;
+    int splitBin = 0;
+    float centroidMin = 0.0f;
+    float binScale = 0.0f;
+    if (!findSplit(node, axis, splitBin, centroidMin, binScale))
+    {
+        if (node.count <= MAX_LEAF_SIZE)
+            return;
+
+        
+        axis = 0;
+        glm::vec3 extent = node.bounds.size();
+        if (extent.y > extent[axis])
+            axis = 1;
+        if (extent.z > extent[axis])
+            axis = 2;
+        std::nth_element(m_indices.begin() + node.leftFirst,
+                         m_indices.begin() + node.leftFirst + node.count / 2,
+                         m_indices.begin() + node.leftFirst + node.count,
+                         [this, axis](int a, int b) { return m_centroids[a][axis] < m_centroids[b][axis]; });
+        splitBin = -1;
+    }
+
+    int leftCount = node.count / 2;
+    if (splitBin >= 0)
+    {
+        
+        int* first = &m_indices[node.leftFirst];
+        int* last = first + node.count;
+        int* middle = std::partition(first, last, [&](int index)
+        {
+            int bin = std::min(SAH_BINS - 1, (int)((m_centroids[index][axis] - centroidMin) * binScale));
+            return bin < splitBin;
+        });
+        leftCount = (int)(middle - first);
+        if (leftCount == 0 || leftCount == node.count)
+            return;
+    }
+
+    int leftIndex = (int)m_nodes.size();
+    m_nodes.push_back(BVHNode());
+    m_nodes.push_back(BVHNode());
+
+    m_nodes[leftIndex].leftFirst = node.leftFirst;
+    m_nodes[leftIndex].count = leftCount;
+    m_nodes[leftIndex + 1].leftFirst = node.leftFirst + leftCount;
+    m_nodes[leftIndex + 1].count = node.count - leftCount;
+    updateNodeBounds(leftIndex);
+    updateNodeBounds(leftIndex + 1);
+
+    m_nodes[nodeIndex].leftFirst = leftIndex;
+    m_nodes[nodeIndex].count = 0;
+
+    subdivide(leftIndex, depth + 1);
+    subdivide(leftIndex + 1, depth + 1);
+}
+
+bool BVH::intersect(const Ray& ray, BVHHit& hit) const
+{
+    if (m_nodes.empty())
+        return false;
+
+    const glm::vec3& invDir = ray.invDirection;
+    bool found = false;
+
+    float rootEntry;
+    if (!slabEntry(m_nodes[0].bounds, ray.origin, invDir, hit.distance, rootEntry))
+        return false;
+
+    int stack[MAX_DEPTH * 2];
+    float stackEntry[MAX_DEPTH * 2];
+    int stackSize = 0;
+    stack[stackSize] = 0;
+    stackEntry[stackSize++] = rootEntry;
+
+    while (stackSize > 0)
+    {
+        --stackSize;
+        if (stackEntry[stackSize] >= hit.distance)
+            continue;
+
+        const BVHNode& node = m_nodes[stack[stackSize]];
+        if (node.isLeaf())
+        {
+            float tNear;
+            int slot = RayBoxKernel::intersectNearest(ray, m_leafBoxes, node.leftFirst, node.count, hit.distance, tNear);
+            if (slot >= 0)
+            {
+                hit.distance = tNear;
+                hit.primitive = m_indices[slot];
+                found = true;
+            }
+            continue;
+        }
+
+        
+        int first = node.leftFirst;
+        int second = node.leftFirst + 1;
+        float firstEntry, secondEntry;
+        bool firstHit = slabEntry(m_nodes[first].bounds, ray.origin, invDir, hit.distance, firstEntry);
+        bool secondHit = slabEntry(m_nodes[second].bounds, ray.origin, invDir, hit.distance, secondEntry);
+
+        if (firstHit && secondHit && secondEntry < firstEntry)
+        {
+            std::swap(first, second);
+            std::swap(firstEntry, secondEntry);
+        }
+
+        if (secondHit)
+        {
+            stack[stackSize] = second;
+            stackEntry[stackSize++] = secondEntry;
+        }
+        if (firstHit)
+        {
+            stack[stackSize] = first;
+            stackEntry[stackSize++] = firstEntry;
+        }
+    }
+
+    return found;
+}
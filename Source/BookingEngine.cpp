@@ -0,0 +1,454 @@
+﻿#include "../Header/BookingEngine.h"
+#include "../Header/SeatGrid.h"
+#include "../Header/BitScan.h"
+#include <algorithm>
+#include <thread>
+
+BookingEngine::BookingEngine()
+    : m_seatCount(0)
+    , m_dirtyWords(0)
+    , m_wordsPerRow(0)
+    , m_rows(0)
+    , m_cols(0)
+    , m_nextSession(1)
+    , m_epoch(std::chrono::steady_clock::now())
+{
+}
+
+BookingEngine::~BookingEngine()
+{
+}
+
+void BookingEngine::init(const SeatGrid& grid)
+{
+    m_rows = grid.getRows();
+    m_cols = grid.getCols();
+    m_seatCount = grid.getSeatCount();
+    m_dirtyWords = (m_seatCount + 63) / 64;
+    m_wordsPerRow = (m_cols + 63) / 64;
+    
+    m_seats.reset(new std::atomic<uint64_t>[m_seatCount]);
+    m_dirty.reset(new std::atomic<uint64_t>[m_dirtyWords]);
+    m_timedHolds.reset(new std::atomic<uint64_t>[m_dirtyWords]);
+    for (int w = 0; w < m_dirtyWords; ++w)
+    {
+        m_dirty[w].store(0, std::memory_order_relaxed);
+        m_timedHolds[w].store(0, std::memory_order_relaxed);
+    }
+    m_freeBits.reset(new std::atomic<uint64_t>[m_rows * m_wordsPerRow]);
+    for (int w = 0; w < m_rows * m_wordsPerRow; ++w)
+        m_freeBits[w].store(0, std::memory_order_relaxed);
+    m_rowFree.reset(new std::atomic<int>[m_rows]);
+    for (int row = 0; row < m_rows; ++row)
+        m_rowFree[row].store(0, std::memory_order_relaxed);
+    
+    
+    for (int i = 0; i < m_seatCount; ++i)
+    {
+        uint64_t word = pack(STATE_FREE, 0, 0);
+        SeatState state = grid.getSeatState(i);
+        if (state == SeatState::Reserved)
+            word = pack(STATE_HELD, 0, NEVER_EXPIRES);
+        else if (state == SeatState::Purchased)
+            word = pack(STATE_PURCHASED, 0, NEVER_EXPIRES);
+        m_seats[i].store(word, std::memory_order_relaxed);
+        if (state == SeatState::Free)
+            setFree(i, true);
+    }
+    std::atomic_thread_fence(std::memory_order_release);
+}
+
+void BookingEngine::reset()
+{
+    
+    
+    for (int i = 0; i < m_seatCount; ++i)
+    {
+        std::atomic<uint64_t>& seat = m_seats[i];
+        uint64_t word = seat.load(std::memory_order_acquire);
+        while (word != pack(STATE_FREE, 0, 0))
+        {
+            if (stateOf(word) == STATE_COMMITTING)
+            {
+                std::this_thread::yield();
+                word = seat.load(std::memory_order_acquire);
+                continue;
+            }
+            
+            if (seat.compare_exchange_weak(word, pack(STATE_FREE, 0, 0), std::memory_order_acq_rel, std::memory_order_acquire))
+            {
+                markDirty(i);
+                setFree(i, true);
+                break;
+            }
+        }
+    }
+}
+
+uint32_t BookingEngine::createSession()
+{
+    
+    uint32_t session = m_nextSession.fetch_add(1, std::memory_order_relaxed) & HOLDER_MASK;
+    while (session == 0)
+        session = m_nextSession.fetch_add(1, std::memory_order_relaxed) & HOLDER_MASK;
+    return session;
+}
+
+uint32_t BookingEngine::nowMs() const
+{
+    auto elapsed = std::chrono::steady_clock::now() - m_epoch;
+    return (uint32_t)std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count();
+}
+
+bool BookingEngine::isClaimable(uint64_t word, uint32_t now) const
+{
+    uint64_t state = stateOf(word);
+    if (state == STATE_FREE)
+        return true;
+    
+    return isTimedHold(word) && hasExpired(expiryOf(word), now);
+}
+
+bool BookingEngine::prepareGroup(const int* seats, int count, int* sorted) const
+{
+    if (count < 1 || count > MAX_GROUP_SIZE)
+        return false;
+    
+    
+    std::copy(seats, seats + count, sorted);
+    std::sort(sorted, sorted + count);
+    for (int i = 0; i < count; ++i)
+    {
+        if (sorted[i] < 0 || sorted[i] >= m_seatCount || (i > 0 && sorted[i] == sorted[i - 1]))
+            return false;
+    }
+    return true;
+}
+
+void BookingEngine::markDirty(int seat)
+{
+    m_dirty[seat / 64].fetch_or(1ull << (seat % 64), std::memory_order_release);
+}
+
+void BookingEngine::setFree(int seat, bool free)
+{
+    int row = seat / m_cols;
+    int col = seat % m_cols;
+    m_rowFree[row].fetch_add(free ? 1 : -1, std::memory_order_relaxed);
+    
+    
+    
+    
+    std::atomic<uint64_t>& bits = m_freeBits[row * m_wordsPerRow + col / 64];
+    uint64_t bit = 1ull << (col % 64);
+    bool isFree = free;
+    for (;;)
+    {
+        if (isFree)
+            bits.fetch_or(bit, std::memory_order_acq_rel);
+        else
+            bits.fetch_and(~bit, std::memory_order_acq_rel);
+        
+        bool nowFree = stateOf(m_seats[seat].load(std::memory_order_acquire)) == STATE_FREE;
+        if (nowFree == isFree)
+            break;
+        isFree = nowFree;
+    }
+}
+
+void BookingEngine::trackHold(int seat, uint64_t word)
+{
+    if (isTimedHold(word))
+        m_timedHolds[seat / 64].fetch_or(1ull << (seat % 64), std::memory_order_release);
+}
+
+void BookingEngine::untrackHold(int seat)
+{
+    
+    
+    
+    std::atomic<uint64_t>& bits = m_timedHolds[seat / 64];
+    uint64_t bit = 1ull << (seat % 64);
+    bits.fetch_and(~bit, std::memory_order_acq_rel);
+    if (isTimedHold(m_seats[seat].load(std::memory_order_acquire)))
+        bits.fetch_or(bit, std::memory_order_release);
+}
+
+bool BookingEngine::hold(uint32_t session, const int* seats, int count, int durationMs)
+{
+    int sorted[MAX_GROUP_SIZE];
+    uint64_t previous[MAX_GROUP_SIZE];
+    if (session == 0 || !prepareGroup(seats, count, sorted))
+        return false;
+    
+    uint32_t now = nowMs();
+    uint32_t expiry = durationMs > 0 ? now + (uint32_t)durationMs : NEVER_EXPIRES;
+    if (durationMs > 0 && expiry == NEVER_EXPIRES)
+        --expiry;
+    uint64_t held = pack(STATE_HELD, session, expiry);
+    
+    int claimed = 0;
+    for (; claimed < count; ++claimed)
+    {
+        std::atomic<uint64_t>& seat = m_seats[sorted[claimed]];
+        uint64_t word = seat.load(std::memory_order_acquire);
+        bool won = false;
+        while (isClaimable(word, now))
+        {
+            if (seat.compare_exchange_weak(word, held, std::memory_order_acq_rel, std::memory_order_acquire))
+            {
+                previous[claimed] = word;
+                if (stateOf(word) == STATE_FREE)
+                    setFree(sorted[claimed], false);
+                won = true;
+                break;
+            }
+        }
+        if (!won)
+            break;
+    }
+    
+    if (claimed < count)
+    {
+        
+        for (int i = 0; i < claimed; ++i)
+        {
+            uint64_t expected = held;
+            if (!m_seats[sorted[i]].compare_exchange_strong(expected, previous[i], std::memory_order_acq_rel))
+                continue;
+            if (stateOf(previous[i]) == STATE_FREE)
+                setFree(sorted[i], true);
+            else
+                trackHold(sorted[i], previous[i]);
+        }
+        return false;
+    }
+    
+    for (int i = 0; i < count; ++i)
+    {
+        markDirty(sorted[i]);
+        trackHold(sorted[i], held);
+    }
+    return true;
+}
+
+bool BookingEngine::confirm(uint32_t session, const int* seats, int count)
+{
+    int sorted[MAX_GROUP_SIZE];
+    uint64_t previous[MAX_GROUP_SIZE];
+    if (session == 0 || !prepareGroup(seats, count, sorted))
+        return false;
+    
+    
+    
+    uint32_t now = nowMs();
+    uint64_t committing = pack(STATE_COMMITTING, session, NEVER_EXPIRES);
+    
+    int locked = 0;
+    for (; locked < count; ++locked)
+    {
+        std::atomic<uint64_t>& seat = m_seats[sorted[locked]];
+        uint64_t word = seat.load(std::memory_order_acquire);
+        bool won = false;
+        while (stateOf(word) == STATE_HELD && holderOf(word) == session &&
+               (expiryOf(word) == NEVER_EXPIRES || !hasExpired(expiryOf(word), now)))
+        {
+            if (seat.compare_exchange_weak(word, committing, std::memory_order_acq_rel, std::memory_order_acquire))
+            {
+                previous[locked] = word;
+                won = true;
+                break;
+            }
+        }
+        if (!won)
+            break;
+    }
+    
+    if (locked < count)
+    {
+        for (int i = 0; i < locked; ++i)
+        {
+            uint64_t expected = committing;
+            if (m_seats[sorted[i]].compare_exchange_strong(expected, previous[i], std::memory_order_acq_rel))
+                trackHold(sorted[i], previous[i]);
+        }
+        return false;
+    }
+    
+    
+    bool all = true;
+    for (int i = 0; i < count; ++i)
+    {
+        uint64_t expected = committing;
+        if (!m_seats[sorted[i]].compare_exchange_strong(expected, pack(STATE_PURCHASED, session, NEVER_EXPIRES),
+                                                        std::memory_order_acq_rel))
+        {
+            all = false;
+            continue;
+        }
+        markDirty(sorted[i]);
+    }
+    return all;
+}
+
+bool BookingEngine::release(uint32_t session, const int* seats, int count)
+{
+    int sorted[MAX_GROUP_SIZE];
+    if (session == 0 || !prepareGroup(seats, count, sorted))
+        return false;
+    
+    bool all = true;
+    for (int i = 0; i < count; ++i)
+    {
+        std::atomic<uint64_t>& seat = m_seats[sorted[i]];
+        uint64_t word = seat.load(std::memory_order_acquire);
+        bool released = false;
+        while (stateOf(word) == STATE_HELD && holderOf(word) == session)
+        {
+            if (seat.compare_exchange_weak(word, pack(STATE_FREE, 0, 0), std::memory_order_acq_rel, std::memory_order_acquire))
+            {
+                released = true;
+                markDirty(sorted[i]);
+                setFree(sorted[i], true);
+                break;
+            }
+        }
+        all = all && released;
+    }
+    return all;
+}
+
+bool BookingEngine::purchase(uint32_t session, const int* seats, int count)
+{
+    if (!hold(session, seats, count, NO_EXPIRY))
+        return false;
+    if (confirm(session, seats, count))
+        return true;
+    
+    release(session, seats, count);
+    return false;
+}
+
+bool BookingEngine::holdAdjacent(uint32_t session, int count, int durationMs, int* seatsOut)
+{
+    if (count < 1 || count > MAX_GROUP_SIZE || count > m_cols)
+        return false;
+    
+    
+    
+    
+    for (int row = m_rows - 1; row >= 0; --row)
+    {
+        if (m_rowFree[row].load(std::memory_order_relaxed) < count)
+            continue;
+        
+        const std::atomic<uint64_t>* words = &m_freeBits[row * m_wordsPerRow];
+        for (int w = m_wordsPerRow - 1; w >= 0; --w)
+        {
+            uint64_t bits = words[w].load(std::memory_order_acquire);
+            if (!bits)
+                continue;
+            uint64_t next = w + 1 < m_wordsPerRow ? words[w + 1].load(std::memory_order_acquire) : 0;
+            
+            uint64_t runStarts = bits;
+            for (int shift = 1; shift < count && runStarts; ++shift)
+                runStarts &= (bits >> shift) | (next << (64 - shift));
+            
+            while (runStarts)
+            {
+                int bit = highestBit(runStarts);
+                runStarts &= ~(1ull << bit);
+                
+                int start = row * m_cols + w * 64 + bit;
+                for (int i = 0; i < count; ++i)
+                    seatsOut[i] = start + i;
+                if (hold(session, seatsOut, count, durationMs))
+                    return true;
+            }
+        }
+    }
+    return false;
+}
+
+bool BookingEngine::purchaseAdjacent(uint32_t session, int count)
+{
+    int seats[MAX_GROUP_SIZE];
+    if (!holdAdjacent(session, count, NO_EXPIRY, seats))
+        return false;
+    if (confirm(session, seats, count))
+        return true;
+    
+    release(session, seats, count);
+    return false;
+}
+
+int BookingEngine::expireHolds()
+{
+    uint32_t now = nowMs();
+    int expired = 0;
+    for (int w = 0; w < m_dirtyWords; ++w)
+    {
+        uint64_t bits = m_timedHolds[w].load(std::memory_order_acquire);
+        while (bits)
+        {
+            int seat = w * 64 + lowestBit(bits);
+            bits &= bits - 1;
+            
+            uint64_t word = m_seats[seat].load(std::memory_order_acquire);
+            if (isTimedHold(word))
+            {
+                if (!hasExpired(expiryOf(word), now))
+                    continue;
+                if (!m_seats[seat].compare_exchange_strong(word, pack(STATE_FREE, 0, 0), std::memory_order_acq_rel))
+                    continue;
+                
+                markDirty(seat);
+                setFree(seat, true);
+                ++expired;
+            }
+            untrackHold(seat);
+        }
+    }
+    return expired;
+}
+
+void BookingEngine::syncTo(SeatGrid& grid)
+{
+    if (grid.getSeatCount() != m_seatCount)
+        return;
+    
+    for (int w = 0; w < m_dirtyWords; ++w)
+    {
+        if (m_dirty[w].load(std::memory_order_relaxed) == 0)
+            continue;
+        
+        uint64_t bits = m_dirty[w].exchange(0, std::memory_order_acquire);
+        while (bits)
+        {
+            int seat = w * 64 + lowestBit(bits);
+            bits &= bits - 1;
+            
+            grid.setSeatState(seat, getSeatState(seat));
+        }
+    }
+}
+
+SeatState BookingEngine::getSeatState(int seat) const
+{
+    uint64_t word = m_seats[seat].load(std::memory_order_acquire);
+    switch (stateOf(word))
+    {
+    case STATE_PURCHASED:
+        return SeatState::Purchased;
+    case STATE_HELD:
+    case STATE_COMMITTING:
+        return SeatState::Reserved;
+    default:
+        return SeatState::Free;
+    }
+}
+
+uint32_t BookingEngine::getHolder(int seat) const
+{
+    return holderOf(m_seats[seat].load(std::memory_order_acquire));
+}
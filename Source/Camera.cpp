@@ -122,67 +122,7 @@ void Camera::processMovement(float deltaTime)
     }
     
     
-    const float cameraRadius = 0.30f;
-    const float epsilon = 0.001f;
-    const float maxStepHeight = 0.4f;  
-    
-    
-    float supportY = m_position.y;  
-    bool foundSupport = false;
-    
-    for (const AABB& bound : m_additionalBounds)
-    {
-        
-        if (desiredPosition.x >= bound.min.x - cameraRadius && 
-            desiredPosition.x <= bound.max.x + cameraRadius &&
-            desiredPosition.z >= bound.min.z - cameraRadius && 
-            desiredPosition.z <= bound.max.z + cameraRadius)
-        {
-            float platformTop = bound.max.y;
-            
-            
-            if (m_position.y >= platformTop - maxStepHeight && 
-                m_position.y <= platformTop + epsilon)
-            {
-                supportY = std::max(supportY, platformTop);
-                foundSupport = true;
-            }
-        }
-    }
-    
-    
-    glm::vec3 resolvedPosition = desiredPosition;
-    resolvedPosition.y = supportY;  
-    
-    for (const AABB& bound : m_additionalBounds)
-    {
-        
-        if (resolvedPosition.y > bound.max.y + cameraRadius || 
-            resolvedPosition.y < bound.min.y - cameraRadius)
-            continue;  
-        
-        
-        glm::vec3 closestXZ;
-        closestXZ.x = glm::clamp(resolvedPosition.x, bound.min.x, bound.max.x);
-        closestXZ.z = glm::clamp(resolvedPosition.z, bound.min.z, bound.max.z);
-        
-        float dx = resolvedPosition.x - closestXZ.x;
-        float dz = resolvedPosition.z - closestXZ.z;
-        float distSq = dx * dx + dz * dz;
-        
-        if (distSq < cameraRadius * cameraRadius && distSq > epsilon)
-        {
-            
-            float dist = std::sqrt(distSq);
-            float penetration = cameraRadius - dist;
-            glm::vec2 pushDir = glm::normalize(glm::vec2(dx, dz));
-            
-            resolvedPosition.x += pushDir.x * penetration;
-            resolvedPosition.z += pushDir.y * penetration;
-        }
-    }
-    
-    m_position = resolvedPosition;
+    m_position = m_collider.resolve(m_position, desiredPosition);
 }
 
 void Camera::clampToBounds()
@@ -0,0 +1,296 @@
+﻿#include "../Header/CameraCollider.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+CameraCollider::CameraCollider()
+    : m_gridMin(0.0f)
+    , m_cellSize(CELL_SIZE)
+    , m_inverseCellSize(1.0f / CELL_SIZE)
+    , m_cellsX(0)
+    , m_cellsZ(0)
+    , m_visitStamp(0)
+{
+}
+
+void CameraCollider::setColliders(const std::vector<AABB>& colliders)
+{
+    m_colliders = colliders;
+    buildGrid();
+}
+
+void CameraCollider::buildGrid()
+{
+    m_cellStart.clear();
+    m_cellEntries.clear();
+    m_visitStamps.assign(m_colliders.size(), 0);
+    m_visitStamp = 0;
+    m_cellsX = 0;
+    m_cellsZ = 0;
+    if (m_colliders.empty())
+        return;
+    
+    
+    glm::vec2 boundsMin(std::numeric_limits<float>::max());
+    glm::vec2 boundsMax(-std::numeric_limits<float>::max());
+    for (const AABB& bound : m_colliders)
+    {
+        boundsMin = glm::min(boundsMin, glm::vec2(bound.min.x, bound.min.z));
+        boundsMax = glm::max(boundsMax, glm::vec2(bound.max.x, bound.max.z));
+    }
+    
+    glm::vec2 extent = boundsMax - boundsMin;
+    const float minCellSize = CELL_SIZE;
+    m_cellSize = std::max(minCellSize, std::max(extent.x, extent.y) / MAX_CELLS_PER_AXIS);
+    m_inverseCellSize = 1.0f / m_cellSize;
+    m_gridMin = boundsMin;
+    m_cellsX = std::max(1, (int)std::ceil(extent.x * m_inverseCellSize));
+    m_cellsZ = std::max(1, (int)std::ceil(extent.y * m_inverseCellSize));
+    
+    
+    auto cellRange = [this](const AABB& bound, int& x0, int& z0, int& x1, int& z1)
+    {
+        x0 = glm::clamp((int)((bound.min.x - m_gridMin.x) * m_inverseCellSize), 0, m_cellsX - 1);
+        z0 = glm::clamp((int)((bound.min.z - m_gridMin.y) * m_inverseCellSize), 0, m_cellsZ - 1);
+        x1 = glm::clamp((int)((bound.max.x - m_gridMin.x) * m_inverseCellSize), 0, m_cellsX - 1);
+        z1 = glm::clamp((int)((bound.max.z - m_gridMin.y) * m_inverseCellSize), 0, m_cellsZ - 1);
+    };
+    
+    m_cellStart.assign(m_cellsX * m_cellsZ + 1, 0);
+    for (const AABB& bound : m_colliders)
+    {
+        int x0, z0, x1, z1;
+        cellRange(bound, x0, z0, x1, z1);
+        for (int z = z0; z <= z1; ++z)
+            for (int x = x0; x <= x1; ++x)
+                ++m_cellStart[z * m_cellsX + x + 1];
+    }
+    
+    for (int c = 0; c < m_cellsX * m_cellsZ; ++c)
+        m_cellStart[c + 1] += m_cellStart[c];
+    
+    std::vector<uint32_t> cursor(m_cellStart.begin(), m_cellStart.end() - 1);
+    m_cellEntries.resize(m_cellStart.back());
+    for (int i = 0; i < (int)m_colliders.size(); ++i)
+    {
+        int x0, z0, x1, z1;
+        cellRange(m_colliders[i], x0, z0, x1, z1);
+        for (int z = z0; z <= z1; ++z)
+            for (int x = x0; x <= x1; ++x)
+                m_cellEntries[cursor[z * m_cellsX + x]++] = i;
+    }
+}
+
+void CameraCollider::gatherCandidates(const glm::vec2& areaMin, const glm::vec2& areaMax)
+{
+    m_candidates.clear();
+    if (m_cellsX == 0)
+        return;
+    
+    if (++m_visitStamp == 0)
+    {
+        std::fill(m_visitStamps.begin(), m_visitStamps.end(), 0);
+        m_visitStamp = 1;
+    }
+    
+    int x0 = glm::clamp((int)std::floor((areaMin.x - m_gridMin.x) * m_inverseCellSize), 0, m_cellsX - 1);
+    int z0 = glm::clamp((int)std::floor((areaMin.y - m_gridMin.y) * m_inverseCellSize), 0, m_cellsZ - 1);
+    int x1 = glm::clamp((int)std::floor((areaMax.x - m_gridMin.x) * m_inverseCellSize), 0, m_cellsX - 1);
+    int z1 = glm::clamp((int)std::floor((areaMax.y - m_gridMin.y) * m_inverseCellSize), 0, m_cellsZ - 1);
+    
+    for (int z = z0; z <= z1; ++z)
+    {
+        for (int x = x0; x <= x1; ++x)
+        {
+            int cell = z * m_cellsX + x;
+            for (uint32_t e = m_cellStart[cell]; e < m_cellStart[cell + 1]; ++e)
+            {
+                int index = m_cellEntries[e];
+                if (m_visitStamps[index] == m_visitStamp)
+                    continue;
+                m_visitStamps[index] = m_visitStamp;
+                
+                const AABB& bound = m_colliders[index];
+                if (bound.max.x >= areaMin.x && bound.min.x <= areaMax.x &&
+                    bound.max.z >= areaMin.y && bound.min.z <= areaMax.y)
+                {
+                    m_candidates.push_back(index);
+                }
+            }
+        }
+    }
+}
+
+bool CameraCollider::sweepCircle(const glm::vec2& start, const glm::vec2& move, const AABB& bound,
+                                 float& timeOfImpact, glm::vec2& normal) const
+{
+    
+    glm::vec2 rectMin(bound.min.x, bound.min.z);
+    glm::vec2 rectMax(bound.max.x, bound.max.z);
+    glm::vec2 expandedMin = rectMin - glm::vec2(CAMERA_RADIUS);
+    glm::vec2 expandedMax = rectMax + glm::vec2(CAMERA_RADIUS);
+    
+    float tEnter = -std::numeric_limits<float>::max();
+    float tExit = std::numeric_limits<float>::max();
+    int enterAxis = -1;
+    for (int axis = 0; axis < 2; ++axis)
+    {
+        if (std::fabs(move[axis]) < 1e-8f)
+        {
+            if (start[axis] <= expandedMin[axis] || start[axis] >= expandedMax[axis])
+                return false;
+            continue;
+        }
+        
+        float inv = 1.0f / move[axis];
+        float t0 = (expandedMin[axis] - start[axis]) * inv;
+        float t1 = (expandedMax[axis] - start[axis]) * inv;
+        if (t0 > t1)
+            std::swap(t0, t1);
+        if (t0 > tEnter)
+        {
+            tEnter = t0;
+            enterAxis = axis;
+        }
+        tExit = std::min(tExit, t1);
+    }
+    
+    
+    if (enterAxis < 0 || tEnter > tExit || tEnter < 0.0f || tEnter > 1.0f)
+        return false;
+    
+    glm::vec2 hitPoint = start + move * tEnter;
+    bool outsideX = hitPoint.x < rectMin.x || hitPoint.x > rectMax.x;
+    bool outsideZ = hitPoint.y < rectMin.y || hitPoint.y > rectMax.y;
+    
+    if (outsideX && outsideZ)
+    {
+        
+        glm::vec2 corner(hitPoint.x < rectMin.x ? rectMin.x : rectMax.x,
+                         hitPoint.y < rectMin.y ? rectMin.y : rectMax.y);
+        glm::vec2 toStart = start - corner;
+        float a = glm::dot(move, move);
+        float b = glm::dot(toStart, move);
+        float c = glm::dot(toStart, toStart) - CAMERA_RADIUS * CAMERA_RADIUS;
+        float discriminant = b * b - a * c;
+        if (c <= 0.0f || b >= 0.0f || discriminant < 0.0f)
+            return false;
+        
+        float t = (-b - std::sqrt(discriminant)) / a;
+        if (t < 0.0f || t > 1.0f)
+            return false;
+        
+        timeOfImpact = t;
+        normal = glm::normalize(start + move * t - corner);
+        return true;
+    }
+    
+    timeOfImpact = tEnter;
+    normal = glm::vec2(0.0f);
+    normal[enterAxis] = move[enterAxis] > 0.0f ? -1.0f : 1.0f;
+    return true;
+}
+
+glm::vec3 CameraCollider::resolve(const glm::vec3& currentPosition, const glm::vec3& desiredPosition)
+{
+    glm::vec2 start(currentPosition.x, currentPosition.z);
+    glm::vec2 target(desiredPosition.x, desiredPosition.z);
+    
+    
+    glm::vec2 areaMin = glm::min(start, target) - glm::vec2(CAMERA_RADIUS + SKIN_WIDTH);
+    glm::vec2 areaMax = glm::max(start, target) + glm::vec2(CAMERA_RADIUS + SKIN_WIDTH);
+    gatherCandidates(areaMin, areaMax);
+    
+    
+    float supportY = currentPosition.y;  
+    for (int index : m_candidates)
+    {
+        const AABB& bound = m_colliders[index];
+        if (desiredPosition.x >= bound.min.x - CAMERA_RADIUS && 
+            desiredPosition.x <= bound.max.x + CAMERA_RADIUS &&
+            desiredPosition.z >= bound.min.z - CAMERA_RADIUS && 
+            desiredPosition.z <= bound.max.z + CAMERA_RADIUS)
+        {
+            float platformTop = bound.max.y;
+            if (currentPosition.y >= platformTop - MAX_STEP_HEIGHT && 
+                currentPosition.y <= platformTop + EPSILON)
+            {
+                supportY = std::max(supportY, platformTop);
+            }
+        }
+    }
+    
+    
+    auto blocksAtHeight = [supportY](const AABB& bound)
+    {
+        return bound.max.y > supportY + EPSILON && supportY >= bound.min.y - CAMERA_RADIUS;
+    };
+    
+    
+    glm::vec2 position = start;
+    glm::vec2 move = target - start;
+    for (int iteration = 0; iteration < MAX_SLIDE_ITERATIONS; ++iteration)
+    {
+        float length = glm::length(move);
+        if (length < EPSILON * 0.01f)
+            break;
+        
+        float earliest = 2.0f;
+        glm::vec2 hitNormal(0.0f);
+        for (int index : m_candidates)
+        {
+            const AABB& bound = m_colliders[index];
+            if (!blocksAtHeight(bound))
+                continue;
+            
+            float t;
+            glm::vec2 normal;
+            if (sweepCircle(position, move, bound, t, normal) && t < earliest)
+            {
+                earliest = t;
+                hitNormal = normal;
+            }
+        }
+        
+        if (earliest > 1.0f)
+        {
+            position += move;
+            break;
+        }
+        
+        
+        float travel = std::max(0.0f, earliest - SKIN_WIDTH / length);
+        position += move * travel;
+        glm::vec2 remaining = move * (1.0f - travel);
+        move = remaining - hitNormal * glm::dot(remaining, hitNormal);
+    }
+    
+    glm::vec3 resolvedPosition(position.x, supportY, position.y);
+    
+    
+    for (int index : m_candidates)
+    {
+        const AABB& bound = m_colliders[index];
+        if (!blocksAtHeight(bound))
+            continue;  
+        
+        float closestX = glm::clamp(resolvedPosition.x, bound.min.x, bound.max.x);
+        float closestZ = glm::clamp(resolvedPosition.z, bound.min.z, bound.max.z);
+        
+        float dx = resolvedPosition.x - closestX;
+        float dz = resolvedPosition.z - closestZ;
+        float distSq = dx * dx + dz * dz;
+        
+        if (distSq < CAMERA_RADIUS * CAMERA_RADIUS && distSq > EPSILON)
+        {
+            float dist = std::sqrt(distSq);
+            float penetration = CAMERA_RADIUS - dist;
+            glm::vec2 pushDir = glm::vec2(dx, dz) / dist;
+            
+            resolvedPosition.x += pushDir.x * penetration;
+            resolvedPosition.z += pushDir.y * penetration;
+        }
+    }
+    
+    return resolvedPosition;
+}
@@ -58,12 +58,9 @@ void Crosshair::draw(Shader* shader, int screenWidth, int screenHeight)
     
     
     glm::mat4 model = glm::mat4(1.0f);
-    glm::mat4 view = glm::mat4(1.0f);
-    glm::mat4 projection = glm::mat4(1.0f);
     
     shader->setMat4("model", model);
-    shader->setMat4("view", view);
-    shader->setMat4("projection", projection);
+    shader->setInt("uOverlay", 1);
     
     
     shader->setVec3("objectColor", glm::vec3(0.5f, 0.5f, 0.5f));
@@ -76,6 +73,8 @@ void Crosshair::draw(Shader* shader, int screenWidth, int screenHeight)
     glDrawArrays(GL_LINES, 0, 4);  
     glBindVertexArray(0);
     
+    shader->setInt("uOverlay", 0);
+    
     
     glEnable(GL_DEPTH_TEST);
 }
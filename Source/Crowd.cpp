@@ -0,0 +1,542 @@
+﻿#include "../Header/Crowd.h"
+#include "../Header/HallNavigation.h"
+#include "../Header/JobSystem.h"
+#include <cmath>
+
+static const float FACE_BACKWARD = 3.14159f;
+static const float TWO_PI = 6.28318f;
+
+Crowd::Crowd()
+    : m_spawnHead(0)
+    , m_spawnTimer(0.0f)
+    , m_navigation(nullptr)
+    , m_seatedCount(0)
+    , m_exitedCount(0)
+{
+    m_spatialHash.setCellSize(2.0f * QUEUE_DISTANCE);
+}
+
+void Crowd::setNavigation(const HallNavigation* navigation)
+{
+    m_navigation = (navigation && navigation->isValid()) ? navigation : nullptr;
+}
+
+void Crowd::reserve(int capacity)
+{
+    m_positions.reserve(capacity);
+    m_doorPositions.reserve(capacity);
+    m_seatPositions.reserve(capacity);
+    m_rotations.reserve(capacity);
+    m_speeds.reserve(capacity);
+    m_colors.reserve(capacity);
+    m_textureIndices.reserve(capacity);
+    m_accesses.reserve(capacity);
+    m_phases.reserve(capacity);
+    m_waitTimes.reserve(capacity);
+    m_pathSteps.reserve(capacity);
+}
+
+void Crowd::clear()
+{
+    m_positions.clear();
+    m_doorPositions.clear();
+    m_seatPositions.clear();
+    m_rotations.clear();
+    m_speeds.clear();
+    m_colors.clear();
+    m_textureIndices.clear();
+    m_accesses.clear();
+    m_phases.clear();
+    m_waitTimes.clear();
+    m_pathSteps.clear();
+    m_arrived.clear();
+    m_previousPositions.clear();
+    m_previousRotations.clear();
+    m_previousPathSteps.clear();
+    m_activeIndices.clear();
+    m_spatialHash.clear();
+    clearSpawnQueue();
+    
+    for (int p = 0; p < (int)CrowdPhase::Count; ++p)
+    {
+        m_phaseLists[p].clear();
+        m_transitions[p].clear();
+    }
+    
+    m_seatedCount = 0;
+    m_exitedCount = 0;
+}
+
+int Crowd::spawn(const glm::vec3& doorPos, const glm::vec3& seatPos, const glm::vec3& baseColor, int textureIndex)
+{
+    int index = size();
+    
+    float groundY = m_navigation ? m_navigation->groundHeight(doorPos) + HALF_PERSON_HEIGHT : doorPos.y;
+    
+    m_positions.push_back(glm::vec3(doorPos.x, groundY, doorPos.z));
+    m_doorPositions.push_back(doorPos);
+    m_seatPositions.push_back(seatPos);
+    m_rotations.push_back(0.0f);
+    m_speeds.push_back(static_cast<float>(DEFAULT_SPEED));
+    m_colors.push_back(baseColor);
+    m_textureIndices.push_back(textureIndex);
+    m_accesses.push_back(m_navigation ? m_navigation->findAccess(seatPos) : -1);
+    m_phases.push_back(CrowdPhase::EnterToRow);
+    m_waitTimes.push_back(0.0f);
+    m_pathSteps.push_back(0);
+    m_phaseLists[(int)CrowdPhase::EnterToRow].push_back(index);
+    
+    return index;
+}
+
+void Crowd::queueSpawn(const glm::vec3& doorPos, const glm::vec3& seatPos, const glm::vec3& baseColor, int textureIndex)
+{
+    SpawnRequest request;
+    request.doorPosition = doorPos;
+    request.seatPosition = seatPos;
+    request.color = baseColor;
+    request.textureIndex = textureIndex;
+    m_spawnQueue.push_back(request);
+}
+
+void Crowd::clearSpawnQueue()
+{
+    m_spawnQueue.clear();
+    m_spawnHead = 0;
+    m_spawnTimer = 0.0f;
+}
+
+void Crowd::releaseQueuedSpawn(float deltaTime)
+{
+    if (getQueuedCount() == 0)
+        return;
+    
+    
+    m_spawnTimer += deltaTime;
+    const SpawnRequest& request = m_spawnQueue[m_spawnHead];
+    if (m_spawnTimer < SPAWN_INTERVAL || !isAreaClear(request.doorPosition, DOOR_CLEARANCE))
+        return;
+    
+    spawn(request.doorPosition, request.seatPosition, request.color, request.textureIndex);
+    m_spawnTimer = 0.0f;
+    
+    if (++m_spawnHead == m_spawnQueue.size())
+        clearSpawnQueue();
+}
+
+template <typename StepFunction>
+void Crowd::runPhase(CrowdPhase phase, CrowdPhase next, JobSystem* jobs, StepFunction step)
+{
+    std::vector<int>& list = m_phaseLists[(int)phase];
+    int count = (int)list.size();
+    if (count == 0)
+        return;
+    
+    
+    m_arrived.resize(count);
+    auto body = [&](int begin, int end)
+    {
+        for (int j = begin; j < end; ++j)
+            m_arrived[j] = step(list[j]) ? 1 : 0;
+    };
+    
+    if (jobs && count > PARALLEL_GRAIN_SIZE)
+        jobs->parallelFor(count, PARALLEL_GRAIN_SIZE, body);
+    else
+        body(0, count);
+    
+    
+    size_t kept = 0;
+    for (int j = 0; j < count; ++j)
+    {
+        if (m_arrived[j])
+            queueTransition(list[j], next);
+        else
+            list[kept++] = list[j];
+    }
+    list.resize(kept);
+}
+
+void Crowd::update(float deltaTime, JobSystem* jobs)
+{
+    releaseQueuedSpawn(deltaTime);
+    snapshotPreviousState();
+    rebuildSpatialHash();
+    
+    
+    runPhase(CrowdPhase::EnterToRow, CrowdPhase::EnterToSeat, jobs,
+        [this, deltaTime](int i) { return stepEnterToRow(i, deltaTime); });
+    runPhase(CrowdPhase::EnterToSeat, CrowdPhase::Seated, jobs,
+        [this, deltaTime](int i) { return stepEnterToSeat(i, deltaTime); });
+    runPhase(CrowdPhase::ExitToAisle, CrowdPhase::ExitToDoor, jobs,
+        [this, deltaTime](int i) { return stepExitToAisle(i, deltaTime); });
+    runPhase(CrowdPhase::ExitToDoor, CrowdPhase::Exited, jobs,
+        [this, deltaTime](int i) { return stepExitToDoor(i, deltaTime); });
+    
+    applyTransitions();
+}
+
+void Crowd::startExiting()
+{
+    std::vector<int>& seated = m_phaseLists[(int)CrowdPhase::Seated];
+    std::vector<int>& leaving = m_phaseLists[(int)CrowdPhase::ExitToAisle];
+    
+    for (int index : seated)
+    {
+        m_phases[index] = CrowdPhase::ExitToAisle;
+        m_accesses[index] = m_navigation ? m_navigation->findAccess(m_seatPositions[index]) : -1;
+        leaving.push_back(index);
+    }
+    
+    m_seatedCount -= (int)seated.size();
+    seated.clear();
+}
+
+glm::vec3 Crowd::getInterpolatedPosition(int index, float alpha) const
+{
+    if (index >= (int)m_previousPositions.size())
+        return m_positions[index];
+    
+    return glm::mix(m_previousPositions[index], m_positions[index], alpha);
+}
+
+float Crowd::getInterpolatedRotation(int index, float alpha) const
+{
+    if (index >= (int)m_previousRotations.size())
+        return m_rotations[index];
+    
+    
+    float from = m_previousRotations[index];
+    float delta = std::remainder(m_rotations[index] - from, TWO_PI);
+    return from + delta * alpha;
+}
+
+bool Crowd::isAreaClear(const glm::vec3& point, float radius) const
+{
+    bool clear = true;
+    m_spatialHash.forEachNear(m_previousPositions, point, radius, [&](int) { clear = false; });
+    return clear;
+}
+
+bool Crowd::stepEnterToRow(int i, float deltaTime)
+{
+    glm::vec3& pos = m_positions[i];
+    
+    bool isFinal = false;
+    glm::vec2 target = nextWaypoint(i, pos, m_pathSteps[i], isFinal);
+    if (target.x != pos.x || target.y != pos.z)
+        m_rotations[i] = std::atan2(target.x - pos.x, target.y - pos.z);
+    
+    followGround(i, deltaTime);
+    if (waitIfBlocked(i, deltaTime))
+        return false;
+    
+    if (!moveTowardPoint(pos, target, m_speeds[i] * deltaTime))
+        return false;
+    if (isFinal)
+        return true;
+    
+    ++m_pathSteps[i];
+    return false;
+}
+
+bool Crowd::stepEnterToSeat(int i, float deltaTime)
+{
+    glm::vec3& pos = m_positions[i];
+    const glm::vec3& seat = m_seatPositions[i];
+    
+    m_rotations[i] = std::atan2(seat.x - pos.x, 0.0f);
+    
+    followGround(i, deltaTime);
+    if (waitIfBlocked(i, deltaTime) || !moveToward(pos.x, seat.x, m_speeds[i], deltaTime))
+        return false;
+    
+    pos = seat + glm::vec3(0.0f, HALF_PERSON_HEIGHT, 0.0f);
+    m_rotations[i] = FACE_BACKWARD;
+    return true;
+}
+
+bool Crowd::stepExitToAisle(int i, float deltaTime)
+{
+    if (m_accesses[i] < 0)
+        return true;
+    
+    glm::vec3& pos = m_positions[i];
+    float aisleX = m_navigation->getAccess(m_accesses[i]).position.x;
+    
+    m_rotations[i] = std::atan2(aisleX - pos.x, 0.0f);
+    
+    followGround(i, deltaTime);
+    if (waitIfBlocked(i, deltaTime))
+        return false;
+    
+    return moveToward(pos.x, aisleX, m_speeds[i], deltaTime);
+}
+
+bool Crowd::stepExitToDoor(int i, float deltaTime)
+{
+    glm::vec3& pos = m_positions[i];
+    
+    bool isFinal = false;
+    glm::vec2 target = nextWaypoint(i, pos, 0, isFinal);
+    if (target.x != pos.x || target.y != pos.z)
+        m_rotations[i] = std::atan2(target.x - pos.x, target.y - pos.z);
+    
+    followGround(i, deltaTime);
+    if (waitIfBlocked(i, deltaTime))
+        return false;
+    
+    if (!moveTowardPoint(pos, target, m_speeds[i] * deltaTime) || !isFinal)
+        return false;
+    
+    const glm::vec3& door = m_doorPositions[i];
+    float groundY = m_navigation ? m_navigation->groundHeight(door) + HALF_PERSON_HEIGHT : door.y;
+    pos = glm::vec3(door.x, groundY, door.z);
+    return true;
+}
+
+glm::vec2 Crowd::nextWaypoint(int i, const glm::vec3& position, int pathStep, bool& isFinal) const
+{
+    bool entering = m_phases[i] == CrowdPhase::EnterToRow;
+    
+    glm::vec2 goal;
+    if (entering && m_accesses[i] >= 0)
+    {
+        const glm::vec3& access = m_navigation->getAccess(m_accesses[i]).position;
+        goal = glm::vec2(access.x, access.z);
+    }
+    else
+    {
+        const glm::vec3& end = entering ? m_seatPositions[i] : m_doorPositions[i];
+        goal = glm::vec2(end.x, end.z);
+    }
+    
+    isFinal = true;
+    if (!m_navigation || (entering && m_accesses[i] < 0))
+        return goal;
+    
+    const NavGrid& grid = m_navigation->getGrid();
+    if (entering)
+    {
+        
+        if (pathStep >= m_navigation->getEntryPathLength(m_accesses[i]))
+            return goal;
+        
+        isFinal = false;
+        glm::vec3 center = grid.cellCenter(m_navigation->getEntryPathCell(m_accesses[i], pathStep));
+        return glm::vec2(center.x, center.z);
+    }
+    
+    
+    const FlowField& field = m_navigation->getExitField();
+    int cell = grid.cellAt(position);
+    if (field.isGoal(cell) || !field.isReachable(cell))
+        return goal;
+    
+    isFinal = false;
+    glm::vec3 center = grid.cellCenter(field.nextCell(grid, cell));
+    return glm::vec2(center.x, center.z);
+}
+
+void Crowd::followGround(int i, float deltaTime)
+{
+    if (!m_navigation)
+        return;
+    
+    glm::vec3& pos = m_positions[i];
+    moveToward(pos.y, m_navigation->groundHeight(pos) + HALF_PERSON_HEIGHT, CLIMB_SPEED, deltaTime);
+}
+
+void Crowd::snapshotPreviousState()
+{
+    
+    m_previousPositions.assign(m_positions.begin(), m_positions.end());
+    m_previousRotations.assign(m_rotations.begin(), m_rotations.end());
+    m_previousPathSteps.assign(m_pathSteps.begin(), m_pathSteps.end());
+}
+
+void Crowd::rebuildSpatialHash()
+{
+    m_activeIndices.clear();
+    for (int p = 0; p < (int)CrowdPhase::Count; ++p)
+    {
+        CrowdPhase phase = (CrowdPhase)p;
+        if (phase == CrowdPhase::Seated || phase == CrowdPhase::Exited)
+            continue;
+        m_activeIndices.insert(m_activeIndices.end(), m_phaseLists[p].begin(), m_phaseLists[p].end());
+    }
+    
+    m_spatialHash.build(m_previousPositions, m_activeIndices);
+}
+
+glm::vec2 Crowd::travelDirection(int index) const
+{
+    const glm::vec3& pos = m_previousPositions[index];
+    
+    glm::vec2 target;
+    switch (m_phases[index])
+    {
+    case CrowdPhase::EnterToRow:
+    case CrowdPhase::ExitToDoor:
+    {
+        bool isFinal = false;
+        target = nextWaypoint(index, pos, m_previousPathSteps[index], isFinal);
+        break;
+    }
+    case CrowdPhase::EnterToSeat:
+        target = glm::vec2(m_seatPositions[index].x, pos.z);
+        break;
+    case CrowdPhase::ExitToAisle:
+        if (m_accesses[index] < 0)
+            return glm::vec2(0.0f);
+        target = glm::vec2(m_navigation->getAccess(m_accesses[index]).position.x, pos.z);
+        break;
+    default:
+        return glm::vec2(0.0f);
+    }
+    
+    glm::vec2 offset(target.x - pos.x, target.y - pos.z);
+    float length = std::sqrt(offset.x * offset.x + offset.y * offset.y);
+    if (length < 1e-4f)
+        return glm::vec2(0.0f);
+    return offset / length;
+}
+
+bool Crowd::isBlocked(int index) const
+{
+    glm::vec2 direction = travelDirection(index);
+    if (direction.x == 0.0f && direction.y == 0.0f)
+        return false;
+    
+    const glm::vec3& self = m_previousPositions[index];
+    int rank = phaseRank(m_phases[index]);
+    bool blocked = false;
+    
+    m_spatialHash.forEachNear(m_previousPositions, self, QUEUE_DISTANCE, [&](int other)
+    {
+        if (blocked || other == index)
+            return;
+        
+        const glm::vec3& pos = m_previousPositions[other];
+        glm::vec2 offset(pos.x - self.x, pos.z - self.z);
+        if (!isAhead(offset, direction))
+            return;
+        
+        
+        if (isAhead(-offset, travelDirection(other)))
+        {
+            int otherRank = phaseRank(m_phases[other]);
+            if (rank > otherRank || (rank == otherRank && index < other))
+                return;
+        }
+        blocked = true;
+    });
+    
+    return blocked;
+}
+
+bool Crowd::waitIfBlocked(int index, float deltaTime)
+{
+    float& waited = m_waitTimes[index];
+    if (!isBlocked(index))
+    {
+        waited = 0.0f;
+        return false;
+    }
+    
+    
+    waited += deltaTime;
+    if (waited < YIELD_TIMEOUT)
+        return true;
+    if (waited >= YIELD_TIMEOUT + PUSH_THROUGH_TIME)
+        waited = 0.0f;
+    return false;
+}
+
+void Crowd::queueTransition(int index, CrowdPhase next)
+{
+    m_transitions[(int)next].push_back(index);
+}
+
+void Crowd::applyTransitions()
+{
+    
+    for (int p = 0; p < (int)CrowdPhase::Count; ++p)
+    {
+        std::vector<int>& incoming = m_transitions[p];
+        if (incoming.empty())
+            continue;
+        
+        CrowdPhase phase = (CrowdPhase)p;
+        for (int index : incoming)
+            m_phases[index] = phase;
+        
+        if (phase == CrowdPhase::Seated)
+            m_seatedCount += (int)incoming.size();
+        else if (phase == CrowdPhase::Exited)
+            m_exitedCount += (int)incoming.size();
+        
+        if (phase != CrowdPhase::Exited)
+            m_phaseLists[p].insert(m_phaseLists[p].end(), incoming.begin(), incoming.end());
+        
+        incoming.clear();
+    }
+}
+
+bool Crowd::moveToward(float& current, float target, float speed, float dt)
+{
+    float diff = target - current;
+    
+    if (std::abs(diff) < EPSILON)
+    {
+        current = target;
+        return true;
+    }
+    
+    float step = speed * dt;
+    if (std::abs(diff) < step)
+    {
+        current = target;
+        return true;
+    }
+    
+    current += (diff > 0 ? step : -step);
+    return false;
+}
+
+bool Crowd::moveTowardPoint(glm::vec3& position, const glm::vec2& target, float step)
+{
+    glm::vec2 offset(target.x - position.x, target.y - position.z);
+    float distance = std::sqrt(offset.x * offset.x + offset.y * offset.y);
+    
+    if (distance < EPSILON || distance <= step)
+    {
+        position.x = target.x;
+        position.z = target.y;
+        return true;
+    }
+    
+    position.x += offset.x / distance * step;
+    position.z += offset.y / distance * step;
+    return false;
+}
+
+bool Crowd::isAhead(const glm::vec2& offset, const glm::vec2& direction)
+{
+    float along = offset.x * direction.x + offset.y * direction.y;
+    float lateral = std::abs(offset.x * direction.y - offset.y * direction.x);
+    return along > 0.0f && along < QUEUE_DISTANCE && lateral < 2.0f * PERSON_RADIUS;
+}
+
+int Crowd::phaseRank(CrowdPhase phase)
+{
+    
+    switch (phase)
+    {
+    case CrowdPhase::EnterToSeat:
+    case CrowdPhase::ExitToAisle:
+        return 0;
+    default:
+        return 1;
+    }
+}
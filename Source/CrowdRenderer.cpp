@@ -0,0 +1,206 @@
+﻿#include "../Header/CrowdRenderer.h"
+#include "../Header/HumanMesh.h"
+#include "../Header/Log.h"
+#include "../Shader.h"
+#include <GL/glew.h>
+#include <cstddef>
+
+CrowdRenderer::CrowdRenderer()
+    : m_mesh(nullptr)
+    , m_shader(nullptr)
+    , m_VAO(0)
+    , m_instanceVBO(0)
+    , m_capacity(0)
+    , m_persistent(false)
+    , m_mapped(nullptr)
+    , m_region(0)
+    , m_staging(nullptr)
+{
+    for (int i = 0; i < REGION_COUNT; ++i)
+        m_fences[i] = nullptr;
+}
+
+CrowdRenderer::~CrowdRenderer()
+{
+    cleanup();
+}
+
+bool CrowdRenderer::init(HumanMesh* mesh, Shader* shader)
+{
+    if (!mesh || !shader)
+        return false;
+
+    m_mesh = mesh;
+    m_shader = shader;
+    m_persistent = GLEW_ARB_buffer_storage ? true : false;
+
+    glGenVertexArrays(1, &m_VAO);
+    glBindVertexArray(m_VAO);
+    m_mesh->bindVertexAttributes();
+    glBindVertexArray(0);
+
+    allocate(256);
+
+    LOG_INFO(std::string("[CROWD] Instanced renderer using ") +
+             (m_persistent ? "persistently mapped" : "orphaned") + " instance buffer");
+    return true;
+}
+
+void CrowdRenderer::cleanup()
+{
+    releaseBuffer();
+
+    if (m_VAO)
+    {
+        glDeleteVertexArrays(1, &m_VAO);
+        m_VAO = 0;
+    }
+
+    delete[] m_staging;
+    m_staging = nullptr;
+    m_capacity = 0;
+}
+
+void CrowdRenderer::allocate(int capacity)
+{
+    releaseBuffer();
+
+    m_capacity = capacity;
+    glGenBuffers(1, &m_instanceVBO);
+    glBindBuffer(GL_ARRAY_BUFFER, m_instanceVBO);
+
+    if (m_persistent)
+    {
+        GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+        GLsizeiptr size = (GLsizeiptr)(sizeof(CrowdInstance) * capacity * REGION_COUNT);
+        glBufferStorage(GL_ARRAY_BUFFER, size, nullptr, flags);
+        m_mapped = static_cast<CrowdInstance*>(glMapBufferRange(GL_ARRAY_BUFFER, 0, size, flags));
+
+        if (!m_mapped)
+        {
+            LOG_WARNING("[CROWD] Persistent mapping failed, falling back to buffer orphaning");
+            m_persistent = false;
+            glBindBuffer(GL_ARRAY_BUFFER, 0);
+            allocate(capacity);
+            return;
+        }
+    }
+    else
+    {
+        glBufferData(GL_ARRAY_BUFFER, (GLsizeiptr)(sizeof(CrowdInstance) * capacity), nullptr, GL_STREAM_DRAW);
+        delete[] m_staging;
+        m_staging = new CrowdInstance[capacity];
+    }
+
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    m_region = 0;
+}
+
+void CrowdRenderer::releaseBuffer()
+{
+    for (int i = 0; i < REGION_COUNT; ++i)
+    {
+        if (m_fences[i])
+        {
+            glDeleteSync((GLsync)m_fences[i]);
+            m_fences[i] = nullptr;
+        }
+    }
+
+    if (m_instanceVBO)
+    {
+        if (m_mapped)
+        {
+            glBindBuffer(GL_ARRAY_BUFFER, m_instanceVBO);
+            glUnmapBuffer(GL_ARRAY_BUFFER);
+            glBindBuffer(GL_ARRAY_BUFFER, 0);
+            m_mapped = nullptr;
+        }
+        glDeleteBuffers(1, &m_instanceVBO);
+        m_instanceVBO = 0;
+    }
+}
+
+CrowdInstance* CrowdRenderer::beginFrame(int count)
+{
+    if (!isInitialized() || count <= 0)
+        return nullptr;
+
+    if (count > m_capacity)
+    {
+        int capacity = m_capacity;
+        while (capacity < count)
+            capacity *= 2;
+        allocate(capacity);
+    }
+
+    if (!m_persistent)
+        return m_staging;
+
+    
+    m_region = (m_region + 1) % REGION_COUNT;
+    if (m_fences[m_region])
+    {
+        GLsync fence = (GLsync)m_fences[m_region];
+        while (glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000) == GL_TIMEOUT_EXPIRED)
+        {
+        }
+        glDeleteSync(fence);
+        m_fences[m_region] = nullptr;
+    }
+
+    return m_mapped + (size_t)m_region * m_capacity;
+}
+
+void CrowdRenderer::bindInstanceAttributes(size_t byteOffset)
+{
+    glBindBuffer(GL_ARRAY_BUFFER, m_instanceVBO);
+
+    glVertexAttribPointer(3, 4, GL_FLOAT, GL_FALSE, sizeof(CrowdInstance),
+                          (void*)(byteOffset + offsetof(CrowdInstance, positionRotation)));
+    glEnableVertexAttribArray(3);
+    glVertexAttribDivisor(3, 1);
+
+    glVertexAttribPointer(4, 1, GL_FLOAT, GL_FALSE, sizeof(CrowdInstance),
+                          (void*)(byteOffset + offsetof(CrowdInstance, layer)));
+    glEnableVertexAttribArray(4);
+    glVertexAttribDivisor(4, 1);
+
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void CrowdRenderer::draw(int count, const glm::vec3& personScale)
+{
+    if (!isInitialized() || count <= 0)
+        return;
+
+    size_t byteOffset = 0;
+    if (m_persistent)
+    {
+        byteOffset = sizeof(CrowdInstance) * (size_t)m_region * m_capacity;
+    }
+    else
+    {
+        glBindBuffer(GL_ARRAY_BUFFER, m_instanceVBO);
+        glBufferData(GL_ARRAY_BUFFER, (GLsizeiptr)(sizeof(CrowdInstance) * m_capacity), nullptr, GL_STREAM_DRAW);
+        glBufferSubData(GL_ARRAY_BUFFER, 0, (GLsizeiptr)(sizeof(CrowdInstance) * count), m_staging);
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+    }
+
+    m_shader->use();
+    m_shader->setVec3("uPersonScale", personScale);
+
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, m_mesh->getTextureArrayID());
+    m_shader->setInt("uTextures", 0);
+
+    glBindVertexArray(m_VAO);
+    bindInstanceAttributes(byteOffset);
+    glDrawElementsInstanced(GL_TRIANGLES, m_mesh->getIndexCount(), GL_UNSIGNED_INT, (void*)0, count);
+    glBindVertexArray(0);
+
+    glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+
+    if (m_persistent)
+        m_fences[m_region] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+}
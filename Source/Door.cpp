@@ -1,9 +1,12 @@
 ﻿#include "../Header/Door.h"
+#ifndef KOSTUR_HEADLESS_ONLY
 #include "../Header/DebugCube.h"
 #include "../Shader.h"
-#include <glm/gtc/matrix_transform.hpp>
 #include <GL/glew.h>
+#endif
+#include <glm/gtc/matrix_transform.hpp>
 #include <algorithm>
+#include <cmath>
 
 Door::Door()
     : m_isOpen(false)
@@ -12,6 +15,7 @@ Door::Door()
     , m_size(0.1f, 2.5f, 2.0f)            
     , m_color(0.5f, 0.3f, 0.2f)           
     , m_currentAngle(0.0f)
+    , m_previousAngle(0.0f)
     , m_targetAngle(0.0f)
     , m_rotationSpeed(90.0f)              
     , m_cubeMesh(nullptr)
@@ -27,8 +31,16 @@ void Door::init(DebugCube* cubeMesh)
     m_cubeMesh = cubeMesh;
 }
 
+void Door::setPosition(const glm::vec3& position)
+{
+    
+    m_position = position;
+    m_hingePosition = position - glm::vec3(0.0f, 0.0f, m_size.z * 0.5f);
+}
+
 void Door::update(float deltaTime)
 {
+    m_previousAngle = m_currentAngle;
     
     if (m_currentAngle != m_targetAngle)
     {
@@ -58,7 +70,8 @@ void Door::close()
     m_targetAngle = 0.0f;   
 }
 
-void Door::draw(Shader* shader, const glm::mat4& view, const glm::mat4& projection, const glm::vec3& viewPos)
+#ifndef KOSTUR_HEADLESS_ONLY
+void Door::draw(Shader* shader, float interpolation)
 {
     if (!m_cubeMesh || !shader)
         return;
@@ -72,7 +85,8 @@ void Door::draw(Shader* shader, const glm::mat4& view, const glm::mat4& projecti
     model = glm::translate(model, m_hingePosition);
     
     
-    model = glm::rotate(model, glm::radians(m_currentAngle), glm::vec3(0.0f, 1.0f, 0.0f));
+    float angle = m_previousAngle + (m_currentAngle - m_previousAngle) * interpolation;
+    model = glm::rotate(model, glm::radians(angle), glm::vec3(0.0f, 1.0f, 0.0f));
     
     
     glm::vec3 offsetFromHinge(0.0f, 0.0f, m_size.z * 0.5f);
@@ -82,18 +96,26 @@ void Door::draw(Shader* shader, const glm::mat4& view, const glm::mat4& projecti
     model = glm::scale(model, m_size);
     
     shader->setMat4("model", model);
-    shader->setMat4("view", view);
-    shader->setMat4("projection", projection);
     
     
     shader->setVec3("uBaseColor", m_color);
     
-    
-    shader->setVec3("lightPos", glm::vec3(0.0f, 4.0f, 0.0f));
-    shader->setVec3("lightColor", glm::vec3(1.0f, 0.95f, 0.85f));
-    shader->setFloat("lightIntensity", 5.0f);
-    glUniform1i(glGetUniformLocation(shader->ID, "lightEnabled"), 1);
-    shader->setVec3("viewPos", viewPos);
-    
     m_cubeMesh->draw();
 }
+#endif
+
+AABB Door::getBounds() const
+{
+    
+    float angle = glm::radians(m_currentAngle);
+    glm::vec3 axisX(std::cos(angle), 0.0f, -std::sin(angle));
+    glm::vec3 axisZ(std::sin(angle), 0.0f, std::cos(angle));
+    glm::vec3 center = m_hingePosition + axisZ * (m_size.z * 0.5f);
+    
+    glm::vec3 halfExtents(
+        0.5f * (m_size.x * std::fabs(axisX.x) + m_size.z * std::fabs(axisZ.x)),
+        0.5f * m_size.y,
+        0.5f * (m_size.x * std::fabs(axisX.z) + m_size.z * std::fabs(axisZ.z))
+    );
+    return AABB(center - halfExtents, center + halfExtents);
+}
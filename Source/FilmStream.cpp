@@ -0,0 +1,181 @@
+﻿#include "../Header/FilmStream.h"
+#include "../Header/Log.h"
+#include "../Header/stb_image.h"
+#include <GL/glew.h>
+#include <chrono>
+
+static double streamClockMs()
+{
+    return std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+FilmStream::FilmStream()
+    : m_textureArray(0)
+    , m_width(0)
+    , m_height(0)
+    , m_ringSize(0)
+    , m_windowStart(0)
+    , m_nextRequest(0)
+{
+}
+
+FilmStream::~FilmStream()
+{
+    cleanup();
+}
+
+bool FilmStream::init(const std::vector<std::string>& framePaths, int ringSize)
+{
+    cleanup();
+
+    if (framePaths.empty() || ringSize <= 0)
+        return false;
+
+    int channels = 0;
+    if (!stbi_info(framePaths[0].c_str(), &m_width, &m_height, &channels))
+    {
+        LOG_ERROR("[FILM] Cannot read frame header: " + framePaths[0]);
+        return false;
+    }
+
+    m_framePaths = framePaths;
+    m_ringSize = ringSize < (int)framePaths.size() ? ringSize : (int)framePaths.size();
+
+    
+    glGenTextures(1, &m_textureArray);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, m_textureArray);
+    glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, GL_RGBA8, m_width, m_height, m_ringSize, 0,
+                 GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+
+    m_decodePool.init();
+    seek(0);
+
+    LOG_INFO("[FILM] Streaming " + std::to_string(m_framePaths.size()) + " frames through a " +
+             std::to_string(m_ringSize) + "-layer ring (" +
+             std::to_string(getResidentBytes() / (1024 * 1024)) + " MB resident)");
+    return true;
+}
+
+void FilmStream::cleanup()
+{
+    m_decodePool.shutdown();
+    m_uploadBuffer.cleanup();
+
+    if (m_textureArray)
+    {
+        glDeleteTextures(1, &m_textureArray);
+        m_textureArray = 0;
+    }
+
+    m_framePaths.clear();
+    m_layerFrame.clear();
+    m_layerValid.clear();
+    m_ringSize = 0;
+    m_windowStart = 0;
+    m_nextRequest = 0;
+}
+
+void FilmStream::seek(int frame)
+{
+    m_decodePool.cancelPending();
+
+    m_layerFrame.assign(m_ringSize, -1);
+    m_layerValid.assign(m_ringSize, false);
+    m_windowStart = frame;
+    m_nextRequest = frame;
+
+    requestWindow();
+}
+
+void FilmStream::update(int currentFrame, double budgetMs)
+{
+    if (m_ringSize == 0)
+        return;
+
+    if (currentFrame < m_windowStart)
+    {
+        seek(currentFrame);
+    }
+    else if (currentFrame > m_windowStart)
+    {
+        m_windowStart = currentFrame;
+        if (m_nextRequest < m_windowStart)
+            m_nextRequest = m_windowStart;
+    }
+
+    requestWindow();
+
+    double start = streamClockMs();
+    DecodedImage image;
+    while (streamClockMs() - start < budgetMs && m_decodePool.popCompleted(image))
+    {
+        
+        if (image.id >= m_windowStart && image.id < m_windowStart + m_ringSize)
+            uploadFrame(image);
+
+        ImageDecodePool::release(image);
+    }
+}
+
+void FilmStream::requestWindow()
+{
+    
+    int windowEnd = m_windowStart + m_ringSize;
+    if (windowEnd > (int)m_framePaths.size())
+        windowEnd = (int)m_framePaths.size();
+
+    while (m_nextRequest < windowEnd)
+    {
+        m_decodePool.request(m_nextRequest, m_framePaths[m_nextRequest], true, 4);
+        ++m_nextRequest;
+    }
+}
+
+void FilmStream::uploadFrame(const DecodedImage& image)
+{
+    int layer = image.id % m_ringSize;
+    m_layerFrame[layer] = image.id;
+    m_layerValid[layer] = false;
+
+    if (!image.pixels)
+        return;
+
+    if (image.width != m_width || image.height != m_height)
+    {
+        LOG_WARNING("[FILM] Frame " + std::to_string(image.id + 1) + " size does not match the film, skipping");
+        return;
+    }
+
+    size_t byteSize = (size_t)image.width * image.height * 4;
+    const void* source = m_uploadBuffer.stage(image.pixels, byteSize);
+
+    glBindTexture(GL_TEXTURE_2D_ARRAY, m_textureArray);
+    glTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, 0, 0, layer, image.width, image.height, 1,
+                    GL_RGBA, GL_UNSIGNED_BYTE, source);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+    m_uploadBuffer.finish();
+
+    m_layerValid[layer] = true;
+}
+
+bool FilmStream::isFrameResolved(int frame) const
+{
+    if (frame < 0 || m_ringSize == 0)
+        return false;
+    return m_layerFrame[frame % m_ringSize] == frame;
+}
+
+int FilmStream::layerOfFrame(int frame) const
+{
+    if (!isFrameResolved(frame))
+        return -1;
+
+    int layer = frame % m_ringSize;
+    return m_layerValid[layer] ? layer : -1;
+}
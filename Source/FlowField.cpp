@@ -0,0 +1,72 @@
+﻿#include "../Header/FlowField.h"
+#include "../Header/NavGrid.h"
+#include <functional>
+#include <limits>
+#include <queue>
+#include <utility>
+
+static const float DIAGONAL_COST = 1.41421356f;
+
+FlowField::FlowField()
+{
+}
+
+void FlowField::build(const NavGrid& grid, const std::vector<int>& goalCells, bool keepDistances)
+{
+    int cellCount = grid.getCellCount();
+    m_directions.assign(cellCount, static_cast<uint8_t>(UNREACHABLE));
+    m_distances.assign(cellCount, std::numeric_limits<float>::infinity());
+
+    typedef std::pair<float, int> QueueEntry;
+    std::priority_queue<QueueEntry, std::vector<QueueEntry>, std::greater<QueueEntry>> open;
+
+    for (int goal : goalCells)
+    {
+        if (goal < 0 || goal >= cellCount || !grid.isWalkable(goal))
+            continue;
+        m_directions[goal] = GOAL;
+        m_distances[goal] = 0.0f;
+        open.push(QueueEntry(0.0f, goal));
+    }
+
+    
+    while (!open.empty())
+    {
+        QueueEntry entry = open.top();
+        open.pop();
+
+        int cell = entry.second;
+        if (entry.first > m_distances[cell])
+            continue;
+
+        uint8_t links = grid.getLinks(cell);
+        for (int d = 0; d < NavGrid::DIRECTION_COUNT; ++d)
+        {
+            if (!(links & (1 << d)))
+                continue;
+
+            int neighbour = grid.neighbour(cell, d);
+            bool diagonal = d >= 4;
+            float distance = m_distances[cell] + (diagonal ? DIAGONAL_COST : 1.0f);
+            if (distance < m_distances[neighbour])
+            {
+                m_distances[neighbour] = distance;
+                
+                m_directions[neighbour] = (uint8_t)(d ^ 1);
+                open.push(QueueEntry(distance, neighbour));
+            }
+        }
+    }
+
+    if (!keepDistances)
+        std::vector<float>().swap(m_distances);
+}
+
+int FlowField::nextCell(const NavGrid& grid, int cell) const
+{
+    uint8_t direction = m_directions[cell];
+    if (direction == GOAL || direction == UNREACHABLE)
+        return cell;
+
+    return grid.neighbour(cell, direction);
+}
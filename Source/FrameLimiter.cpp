@@ -1,69 +1,153 @@
 ﻿#include "../Header/FrameLimiter.h"
-#include "../Header/Log.h"
-#include <GLFW/glfw3.h>
+#include <algorithm>
 #include <thread>
-#include <chrono>
-#include <iomanip>
-#include <sstream>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#include <timeapi.h>
+#endif
+
+static double toSeconds(std::chrono::steady_clock::duration duration)
+{
+    return std::chrono::duration<double>(duration).count();
+}
 
 FrameLimiter::FrameLimiter(double targetFPS)
     : m_targetFrameTime(1.0 / targetFPS)
-    , m_frameStartTime(0.0)
+    , m_hasDeadline(false)
+    , m_hasLastFrame(false)
+    , m_vsyncPaced(false)
     , m_deltaTime(0.0f)
-    , m_fpsTimer(0.0)
-    , m_frameCount(0)
-    , m_currentFPS(0.0)
+    , m_sleepSlack(0.001)
+    , m_oversleepEstimate(0.0)
+    , m_windowTime(0.0)
+    , m_windowWorkTime(0.0)
+    , m_windowOversleep(0.0)
+    , m_windowMin(0.0)
+    , m_windowMax(0.0)
+    , m_windowFrames(0)
+    , m_windowSleeps(0)
+{
+#ifdef _WIN32
+    
+    timeBeginPeriod(1);
+#endif
+}
+
+FrameLimiter::~FrameLimiter()
+{
+#ifdef _WIN32
+    timeEndPeriod(1);
+#endif
+}
+
+void FrameLimiter::setVSync(bool enabled, double refreshRate)
 {
+    
+    m_vsyncPaced = enabled && refreshRate > 0.0 && 1.0 / refreshRate >= m_targetFrameTime * 0.95;
+    m_hasDeadline = false;
 }
 
 void FrameLimiter::beginFrame()
 {
-    m_frameStartTime = glfwGetTime();
+    m_frameStartTime = Clock::now();
 }
 
 void FrameLimiter::endFrame()
 {
-    double frameEndTime = glfwGetTime();
-    double frameTime = frameEndTime - m_frameStartTime;
-
+    Clock::time_point workEnd = Clock::now();
+    double workTime = toSeconds(workEnd - m_frameStartTime);
     
-    if (frameTime < m_targetFrameTime)
+    if (!m_vsyncPaced)
     {
-        double sleepTime = m_targetFrameTime - frameTime;
+        Clock::duration target = std::chrono::duration_cast<Clock::duration>(
+            std::chrono::duration<double>(m_targetFrameTime));
         
         
-        if (sleepTime > 0.001)
+        if (!m_hasDeadline || workEnd > m_nextDeadline + target)
         {
-            std::this_thread::sleep_for(std::chrono::microseconds(
-                static_cast<long long>((sleepTime - 0.001) * 1000000.0)
-            ));
+            m_nextDeadline = m_frameStartTime + target;
+            m_hasDeadline = true;
         }
-
         
-        while (glfwGetTime() - m_frameStartTime < m_targetFrameTime)
-        {
-            
-        }
+        waitUntil(m_nextDeadline);
+        m_nextDeadline += target;
     }
+    
+    
+    Clock::time_point frameEnd = Clock::now();
+    double frameTime = toSeconds(frameEnd - (m_hasLastFrame ? m_lastFrameEnd : m_frameStartTime));
+    m_lastFrameEnd = frameEnd;
+    m_hasLastFrame = true;
+    m_deltaTime = static_cast<float>(frameTime);
+    recordFrame(frameTime, workTime);
+}
 
+void FrameLimiter::waitUntil(Clock::time_point deadline)
+{
+    Clock::time_point wake = deadline - std::chrono::duration_cast<Clock::duration>(
+        std::chrono::duration<double>(m_sleepSlack));
+    
+    if (Clock::now() < wake)
+    {
+        std::this_thread::sleep_until(wake);
+        
+        
+        double oversleep = std::max(0.0, toSeconds(Clock::now() - wake));
+        if (oversleep > m_oversleepEstimate)
+            m_oversleepEstimate = oversleep;
+        else
+            m_oversleepEstimate += (oversleep - m_oversleepEstimate) * 0.05;
+        
+        const double minSlack = MIN_SLEEP_SLACK;
+        const double maxSlack = MAX_SLEEP_SLACK;
+        m_sleepSlack = std::min(std::max(m_oversleepEstimate * 1.25, minSlack), maxSlack);
+        m_windowOversleep += oversleep;
+        m_windowSleeps++;
+    }
+    
     
-    double actualFrameEnd = glfwGetTime();
-    m_deltaTime = static_cast<float>(actualFrameEnd - m_frameStartTime);
+    while (Clock::now() < deadline)
+    {
+        std::this_thread::yield();
+    }
+}
 
+void FrameLimiter::recordFrame(double frameTime, double workTime)
+{
+    if (m_windowFrames == 0)
+    {
+        m_windowMin = frameTime;
+        m_windowMax = frameTime;
+    }
+    else
+    {
+        m_windowMin = std::min(m_windowMin, frameTime);
+        m_windowMax = std::max(m_windowMax, frameTime);
+    }
     
-    m_frameCount++;
-    m_fpsTimer += m_deltaTime;
+    m_windowFrames++;
+    m_windowTime += frameTime;
+    m_windowWorkTime += workTime;
     
-    if (m_fpsTimer >= 1.0)
+    if (m_windowTime >= STATS_WINDOW)
     {
-        m_currentFPS = static_cast<double>(m_frameCount) / m_fpsTimer;
-        
-        std::ostringstream oss;
-        oss << std::fixed << std::setprecision(1) << "FPS: " << m_currentFPS;
-        LOG_INFO(oss.str());
+        m_stats.frameCount = m_windowFrames;
+        m_stats.fps = m_windowFrames / m_windowTime;
+        m_stats.averageFrameTime = m_windowTime / m_windowFrames;
+        m_stats.minFrameTime = m_windowMin;
+        m_stats.maxFrameTime = m_windowMax;
+        m_stats.averageWorkTime = m_windowWorkTime / m_windowFrames;
+        m_stats.averageOversleep = m_windowSleeps > 0 ? m_windowOversleep / m_windowSleeps : 0.0;
         
-        m_frameCount = 0;
-        m_fpsTimer = 0.0;
+        m_windowTime = 0.0;
+        m_windowWorkTime = 0.0;
+        m_windowOversleep = 0.0;
+        m_windowFrames = 0;
+        m_windowSleeps = 0;
     }
 }
 
@@ -74,5 +158,5 @@ float FrameLimiter::getDeltaTime() const
 
 double FrameLimiter::getCurrentFPS() const
 {
-    return m_currentFPS;
+    return m_stats.fps;
 }
@@ -0,0 +1,60 @@
+﻿#include "../Header/FrameUniforms.h"
+#include "../Header/Light.h"
+#include "../Shader.h"
+
+static_assert(sizeof(glm::mat4) == 64 && sizeof(glm::vec3) == 12, "FrameData block layout assumes tightly packed glm types");
+
+FrameUniforms::FrameUniforms()
+    : m_UBO(0)
+    , m_initialized(false)
+{
+}
+
+FrameUniforms::~FrameUniforms()
+{
+    cleanup();
+}
+
+void FrameUniforms::init()
+{
+    if (m_initialized) return;
+    
+    glGenBuffers(1, &m_UBO);
+    glBindBuffer(GL_UNIFORM_BUFFER, m_UBO);
+    glBufferData(GL_UNIFORM_BUFFER, sizeof(Block), nullptr, GL_DYNAMIC_DRAW);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+    
+    glBindBufferBase(GL_UNIFORM_BUFFER, Shader::FRAME_DATA_BINDING, m_UBO);
+    
+    m_initialized = true;
+}
+
+void FrameUniforms::update(const glm::mat4& view, const glm::mat4& projection,
+                           const Light& light, const glm::vec3& viewPos)
+{
+    if (!m_initialized) return;
+    
+    Block block;
+    block.view = view;
+    block.projection = projection;
+    block.lightPos = light.position;
+    block.lightIntensity = light.intensity;
+    block.lightColor = light.color;
+    block.lightEnabled = light.enabled ? 1 : 0;
+    block.viewPos = viewPos;
+    block.padding = 0.0f;
+    
+    glBindBuffer(GL_UNIFORM_BUFFER, m_UBO);
+    glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(Block), &block);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+}
+
+void FrameUniforms::cleanup()
+{
+    if (m_initialized)
+    {
+        glDeleteBuffers(1, &m_UBO);
+        m_UBO = 0;
+        m_initialized = false;
+    }
+}
@@ -0,0 +1,118 @@
+﻿#include "../Header/GpuProfiler.h"
+#include "../Header/Profiler.h"
+#include <GL/glew.h>
+
+GpuProfiler::GpuProfiler()
+    : m_frame(0)
+    , m_depth(0)
+    , m_active(false)
+    , m_initialized(false)
+{
+    for (int f = 0; f < FRAME_LATENCY; ++f)
+    {
+        m_zoneCounts[f] = 0;
+        for (int z = 0; z < MAX_ZONES; ++z)
+        {
+            m_queries[f][z].id = 0;
+            m_queries[f][z].name = nullptr;
+            m_queries[f][z].cpuStart = 0;
+        }
+    }
+}
+
+GpuProfiler::~GpuProfiler()
+{
+    cleanup();
+}
+
+void GpuProfiler::init()
+{
+    for (int f = 0; f < FRAME_LATENCY; ++f)
+    {
+        for (int z = 0; z < MAX_ZONES; ++z)
+        {
+            glGenQueries(1, &m_queries[f][z].id);
+        }
+    }
+    m_initialized = true;
+}
+
+void GpuProfiler::cleanup()
+{
+    if (!m_initialized)
+        return;
+    
+    for (int f = 0; f < FRAME_LATENCY; ++f)
+    {
+        for (int z = 0; z < MAX_ZONES; ++z)
+        {
+            glDeleteQueries(1, &m_queries[f][z].id);
+            m_queries[f][z].id = 0;
+        }
+        m_zoneCounts[f] = 0;
+    }
+    m_initialized = false;
+}
+
+void GpuProfiler::beginFrame()
+{
+    if (!m_initialized)
+        return;
+    
+    
+    m_frame = (m_frame + 1) % FRAME_LATENCY;
+    collect(m_frame);
+    m_zoneCounts[m_frame] = 0;
+}
+
+void GpuProfiler::collect(int frame)
+{
+    for (int z = 0; z < m_zoneCounts[frame]; ++z)
+    {
+        const Query& query = m_queries[frame][z];
+        
+        GLint available = 0;
+        glGetQueryObjectiv(query.id, GL_QUERY_RESULT_AVAILABLE, &available);
+        if (!available)
+            continue;
+        
+        GLuint64 elapsed = 0;
+        glGetQueryObjectui64v(query.id, GL_QUERY_RESULT, &elapsed);
+        Profiler::recordGpuZone(query.name, query.cpuStart, elapsed / 1.0e6);
+    }
+}
+
+void GpuProfiler::beginZone(const char* name)
+{
+    
+    if (m_depth++ > 0 || !m_initialized || m_zoneCounts[m_frame] >= MAX_ZONES)
+        return;
+    
+    Query& query = m_queries[m_frame][m_zoneCounts[m_frame]++];
+    query.name = name;
+    query.cpuStart = Profiler::now();
+    glBeginQuery(GL_TIME_ELAPSED, query.id);
+    m_active = true;
+}
+
+void GpuProfiler::endZone()
+{
+    if (m_depth == 0 || --m_depth > 0 || !m_active)
+        return;
+    
+    glEndQuery(GL_TIME_ELAPSED);
+    m_active = false;
+}
+
+GpuProfileZone::GpuProfileZone(GpuProfiler* profiler, const char* name)
+    : m_profiler(profiler)
+{
+    if (m_profiler)
+        m_profiler->beginZone(name);
+}
+
+GpuProfileZone::~GpuProfileZone()
+{
+    if (m_profiler)
+        m_profiler->endZone();
+}
@@ -0,0 +1,188 @@
+﻿#include "../Header/HallNavigation.h"
+#include "../Header/SeatLayout.h"
+#include "../Header/Log.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+HallNavigation::HallNavigation()
+    : m_doorPosition(0.0f)
+    , m_originZ(0.0f)
+    , m_rowSpacing(1.0f)
+    , m_rows(0)
+    , m_sections(0)
+    , m_valid(false)
+{
+}
+
+bool HallNavigation::build(const AABB& floor,
+                           const SeatLayout& layout,
+                           const std::vector<glm::vec3>& seatPositions,
+                           const std::vector<AABB>& seatBounds,
+                           const std::vector<AABB>& surfaces,
+                           const glm::vec3& doorPosition)
+{
+    m_valid = false;
+    m_accesses.clear();
+    m_pathCells.clear();
+    m_pathStarts.clear();
+
+    if ((int)seatPositions.size() != layout.seatCount())
+    {
+        LOG_ERROR("[NAV] Seat positions do not match the seat layout");
+        return false;
+    }
+
+    if (!m_grid.build(floor, CELL_SIZE, surfaces, seatBounds))
+        return false;
+
+    m_doorPosition = doorPosition;
+    m_originZ = layout.origin.z;
+    m_rowSpacing = layout.seatSpacingZ;
+    m_rows = layout.rows;
+    m_sections = layout.sectionCount();
+
+    
+    std::vector<int> doorCells;
+    for (int cell = 0; cell < m_grid.getCellCount(); ++cell)
+    {
+        glm::vec3 center = m_grid.cellCenter(cell);
+        float dx = center.x - doorPosition.x;
+        float dz = center.z - doorPosition.z;
+        if (dx * dx + dz * dz <= DOOR_RADIUS * DOOR_RADIUS && m_grid.isWalkable(cell))
+            doorCells.push_back(cell);
+    }
+    if (doorCells.empty())
+        doorCells.push_back(m_grid.cellAt(doorPosition));
+
+    m_exitField.build(m_grid, doorCells, true);
+
+    
+    m_sideAccesses.assign(m_rows * m_sections * 2, -1);
+    m_sectionMinX.assign(m_sections, std::numeric_limits<float>::max());
+    std::vector<int> cellAccesses(m_grid.getCellCount(), -1);
+
+    for (int row = 0; row < layout.rows; ++row)
+    {
+        float rowZ = layout.origin.z + row * layout.seatSpacingZ;
+
+        for (int section = 0; section < m_sections; ++section)
+        {
+            float minX = std::numeric_limits<float>::max();
+            float maxX = -std::numeric_limits<float>::max();
+            for (int col = 0; col < layout.cols; ++col)
+            {
+                if (layout.sectionOfColumn(col) != section)
+                    continue;
+                float x = seatPositions[row * layout.cols + col].x;
+                minX = std::min(minX, x);
+                maxX = std::max(maxX, x);
+            }
+            if (minX > maxX)
+                continue;
+
+            m_sectionMinX[section] = std::min(m_sectionMinX[section], minX);
+
+            int* sides = &m_sideAccesses[(row * m_sections + section) * 2];
+            sides[0] = addAccess(row, minX - layout.seatSpacingX, minX, rowZ, cellAccesses);
+            sides[1] = addAccess(row, maxX + layout.seatSpacingX, maxX, rowZ, cellAccesses);
+        }
+    }
+
+    if (m_accesses.empty())
+    {
+        LOG_ERROR("[NAV] No seat row can be reached from the door");
+        return false;
+    }
+
+    buildEntryPaths();
+
+    LOG_INFO("[NAV] Precomputed exit flow field and " + std::to_string(m_accesses.size()) + " row entry paths (" +
+             std::to_string(m_pathCells.size()) + " cells)");
+    m_valid = true;
+    return true;
+}
+
+int HallNavigation::addAccess(int row, float x, float seatX, float rowZ, std::vector<int>& cellAccesses)
+{
+    glm::vec3 position(x, 0.0f, rowZ);
+    int cell = m_grid.cellAt(position);
+
+    
+    if (!m_grid.isWalkable(cell) || !m_exitField.isReachable(cell))
+        return -1;
+
+    float rowHeight = m_grid.heightAt(glm::vec3(seatX, 0.0f, rowZ));
+    if (std::abs(rowHeight - m_grid.getHeight(cell)) > NavGrid::MAX_STEP_HEIGHT)
+        return -1;
+
+    if (cellAccesses[cell] >= 0)
+        return cellAccesses[cell];
+
+    RowAccess access;
+    position.y = m_grid.getHeight(cell);
+    access.position = position;
+    access.cell = cell;
+    access.row = row;
+    cellAccesses[cell] = (int)m_accesses.size();
+    m_accesses.push_back(access);
+    return cellAccesses[cell];
+}
+
+void HallNavigation::buildEntryPaths()
+{
+    
+    m_pathStarts.assign(1, 0);
+    m_pathStarts.reserve(m_accesses.size() + 1);
+
+    for (const RowAccess& access : m_accesses)
+    {
+        size_t begin = m_pathCells.size();
+        int cell = access.cell;
+        m_pathCells.push_back(cell);
+        while (!m_exitField.isGoal(cell))
+        {
+            cell = m_exitField.nextCell(m_grid, cell);
+            m_pathCells.push_back(cell);
+        }
+
+        std::reverse(m_pathCells.begin() + begin, m_pathCells.end());
+        m_pathStarts.push_back((int)m_pathCells.size());
+    }
+
+    m_pathCells.shrink_to_fit();
+}
+
+int HallNavigation::findAccess(const glm::vec3& seatPosition) const
+{
+    if (!m_valid)
+        return -1;
+
+    int row = (int)std::floor((seatPosition.z - m_originZ) / m_rowSpacing + 0.5f);
+    if (row < 0 || row >= m_rows)
+        return -1;
+
+    int section = (int)(std::upper_bound(m_sectionMinX.begin(), m_sectionMinX.end(), seatPosition.x) -
+                        m_sectionMinX.begin()) - 1;
+    section = std::max(0, std::min(section, m_sections - 1));
+
+    
+    const int* sides = &m_sideAccesses[(row * m_sections + section) * 2];
+    int best = -1;
+    float bestCost = std::numeric_limits<float>::max();
+    for (int side = 0; side < 2; ++side)
+    {
+        int a = sides[side];
+        if (a < 0)
+            continue;
+
+        const RowAccess& access = m_accesses[a];
+        float cost = m_exitField.getDistance(access.cell) * CELL_SIZE + std::abs(access.position.x - seatPosition.x);
+        if (cost < bestCost)
+        {
+            bestCost = cost;
+            best = a;
+        }
+    }
+    return best;
+}
@@ -0,0 +1,168 @@
+﻿#include "../Header/ImageDecodePool.h"
+#include "../Header/Log.h"
+#include "../Header/stb_image.h"
+
+ImageDecodePool::ImageDecodePool()
+    : m_inFlight(0)
+    , m_stopping(false)
+{
+}
+
+ImageDecodePool::~ImageDecodePool()
+{
+    shutdown();
+}
+
+bool ImageDecodePool::init(int workerCount)
+{
+    if (!m_workers.empty())
+        return true;
+
+    if (workerCount <= 0)
+    {
+        int hardware = (int)std::thread::hardware_concurrency();
+        workerCount = hardware > 2 ? hardware - 1 : 1;
+        if (workerCount > 4)
+            workerCount = 4;
+    }
+
+    m_stopping = false;
+    for (int i = 0; i < workerCount; ++i)
+    {
+        m_workers.push_back(std::thread(&ImageDecodePool::workerLoop, this));
+    }
+
+    LOG_INFO("[DECODE] Started " + std::to_string(workerCount) + " image decode workers");
+    return true;
+}
+
+void ImageDecodePool::shutdown()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+        m_requests.clear();
+    }
+    m_wake.notify_all();
+    m_completedSignal.notify_all();
+
+    for (std::thread& worker : m_workers)
+    {
+        if (worker.joinable())
+            worker.join();
+    }
+    m_workers.clear();
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (DecodedImage& image : m_completed)
+        release(image);
+    m_completed.clear();
+    m_inFlight = 0;
+}
+
+void ImageDecodePool::request(int id, const std::string& path, bool flipVertically, int desiredChannels)
+{
+    Request req;
+    req.id = id;
+    req.path = path;
+    req.flipVertically = flipVertically;
+    req.desiredChannels = desiredChannels;
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_requests.push_back(req);
+    }
+    m_wake.notify_one();
+}
+
+bool ImageDecodePool::popCompleted(DecodedImage& image)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_completed.empty())
+        return false;
+
+    image = m_completed.front();
+    m_completed.pop_front();
+    return true;
+}
+
+bool ImageDecodePool::waitCompleted(DecodedImage& image)
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_completedSignal.wait(lock, [this]()
+    {
+        return !m_completed.empty() || (m_requests.empty() && m_inFlight == 0) || m_stopping;
+    });
+
+    if (m_completed.empty())
+        return false;
+
+    image = m_completed.front();
+    m_completed.pop_front();
+    return true;
+}
+
+void ImageDecodePool::cancelPending()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_requests.clear();
+}
+
+int ImageDecodePool::getPendingCount() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return (int)m_requests.size() + m_inFlight + (int)m_completed.size();
+}
+
+void ImageDecodePool::release(DecodedImage& image)
+{
+    if (image.pixels)
+    {
+        stbi_image_free(image.pixels);
+        image.pixels = nullptr;
+    }
+}
+
+void ImageDecodePool::workerLoop()
+{
+    while (true)
+    {
+        Request req;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_wake.wait(lock, [this]() { return m_stopping || !m_requests.empty(); });
+            if (m_stopping)
+                return;
+
+            req = m_requests.front();
+            m_requests.pop_front();
+            ++m_inFlight;
+        }
+
+        
+        stbi_set_flip_vertically_on_load_thread(req.flipVertically ? 1 : 0);
+
+        DecodedImage image;
+        image.id = req.id;
+        int fileChannels = 0;
+        image.pixels = stbi_load(req.path.c_str(), &image.width, &image.height, &fileChannels, req.desiredChannels);
+        image.channels = req.desiredChannels > 0 ? req.desiredChannels : fileChannels;
+
+        if (!image.pixels)
+        {
+            LOG_WARNING("[DECODE] Failed to decode image: " + req.path);
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            --m_inFlight;
+            if (m_stopping)
+            {
+                release(image);
+                return;
+            }
+            m_completed.push_back(image);
+        }
+        m_completedSignal.notify_all();
+    }
+}
@@ -0,0 +1,175 @@
+﻿#include "../Header/JobSystem.h"
+#include "../Header/Log.h"
+
+static thread_local const JobSystem* s_queueOwner = nullptr;
+static thread_local int s_queueIndex = 0;
+
+JobSystem::JobSystem()
+    : m_queuedJobs(0)
+    , m_stopping(false)
+{
+}
+
+JobSystem::~JobSystem()
+{
+    shutdown();
+}
+
+bool JobSystem::init(int workerCount)
+{
+    if (!m_queues.empty())
+        return true;
+
+    if (workerCount <= 0)
+    {
+        int hardware = (int)std::thread::hardware_concurrency();
+        workerCount = hardware > 1 ? hardware - 1 : 0;
+    }
+
+    
+    m_stopping = false;
+    for (int i = 0; i <= workerCount; ++i)
+        m_queues.push_back(std::unique_ptr<WorkQueue>(new WorkQueue()));
+
+    for (int i = 1; i <= workerCount; ++i)
+        m_workers.push_back(std::thread(&JobSystem::workerLoop, this, i));
+
+    LOG_INFO("[JOBS] Started job system with " + std::to_string(workerCount) + " worker threads");
+    return true;
+}
+
+void JobSystem::shutdown()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_sleepMutex);
+        m_stopping = true;
+    }
+    m_wake.notify_all();
+
+    for (std::thread& worker : m_workers)
+    {
+        if (worker.joinable())
+            worker.join();
+    }
+    m_workers.clear();
+    m_queues.clear();
+    m_queuedJobs = 0;
+}
+
+void JobSystem::parallelFor(int count, int grainSize, const RangeFunction& body)
+{
+    if (count <= 0)
+        return;
+
+    if (grainSize < 1)
+        grainSize = 1;
+
+    int chunkCount = (count + grainSize - 1) / grainSize;
+    if (m_workers.empty() || chunkCount == 1)
+    {
+        body(0, count);
+        return;
+    }
+
+    std::atomic<int> remaining(chunkCount);
+
+    
+    int queueCount = (int)m_queues.size();
+    int owner = currentQueueIndex();
+    for (int c = 0; c < chunkCount; ++c)
+    {
+        Job job;
+        job.body = &body;
+        job.begin = c * grainSize;
+        job.end = (c + 1) * grainSize < count ? (c + 1) * grainSize : count;
+        job.remaining = &remaining;
+
+        WorkQueue& queue = *m_queues[(owner + c) % queueCount];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.jobs.push_back(job);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_sleepMutex);
+        m_queuedJobs += chunkCount;
+    }
+    m_wake.notify_all();
+
+    
+    while (remaining.load(std::memory_order_acquire) > 0)
+    {
+        if (!tryRunJob(owner))
+            std::this_thread::yield();
+    }
+}
+
+void JobSystem::workerLoop(int queueIndex)
+{
+    s_queueOwner = this;
+    s_queueIndex = queueIndex;
+
+    while (true)
+    {
+        if (tryRunJob(queueIndex))
+            continue;
+
+        std::unique_lock<std::mutex> lock(m_sleepMutex);
+        m_wake.wait(lock, [this]() { return m_stopping || m_queuedJobs.load() > 0; });
+        if (m_stopping)
+            return;
+    }
+}
+
+int JobSystem::currentQueueIndex() const
+{
+    
+    return s_queueOwner == this ? s_queueIndex : 0;
+}
+
+bool JobSystem::tryRunJob(int queueIndex)
+{
+    Job job;
+    if (popLocal(queueIndex, job) || steal(queueIndex, job))
+    {
+        execute(job);
+        return true;
+    }
+    return false;
+}
+
+bool JobSystem::popLocal(int queueIndex, Job& job)
+{
+    WorkQueue& queue = *m_queues[queueIndex];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.jobs.empty())
+        return false;
+
+    job = queue.jobs.back();
+    queue.jobs.pop_back();
+    --m_queuedJobs;
+    return true;
+}
+
+bool JobSystem::steal(int thiefIndex, Job& job)
+{
+    int queueCount = (int)m_queues.size();
+    for (int offset = 1; offset < queueCount; ++offset)
+    {
+        WorkQueue& victim = *m_queues[(thiefIndex + offset) % queueCount];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (victim.jobs.empty())
+            continue;
+
+        job = victim.jobs.front();
+        victim.jobs.pop_front();
+        --m_queuedJobs;
+        return true;
+    }
+    return false;
+}
+
+void JobSystem::execute(const Job& job)
+{
+    (*job.body)(job.begin, job.end);
+    job.remaining->fetch_sub(1, std::memory_order_release);
+}
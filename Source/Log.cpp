@@ -1,22 +1,295 @@
 ﻿#include "../Header/Log.h"
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdarg>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+std::atomic<int> Log::s_minLevel((int)LogLevel::Info);
+
+static const size_t QUEUE_CAPACITY = 1024;
+static const int MESSAGE_SIZE = 512;
+static const int DEFAULT_RATE_LIMIT = 200;
+
+static const char* levelPrefix(LogLevel level)
+{
+    switch (level)
+    {
+        case LogLevel::Info: return "[INFO] ";
+        case LogLevel::Warning: return "[WARNING] ";
+        case LogLevel::Error: return "[ERROR] ";
+    }
+    return "";
+}
+
+static void writeLine(LogLevel level, const char* text)
+{
+    FILE* out = (level == LogLevel::Error) ? stderr : stdout;
+    std::fputs(levelPrefix(level), out);
+    std::fputs(text, out);
+    std::fputc('\n', out);
+}
+
+struct LogSlot
+{
+    std::atomic<size_t> sequence;
+    LogLevel level;
+    char text[MESSAGE_SIZE];
+};
+
+
+class LogBackend
+{
+public:
+    LogBackend()
+        : m_slots(new LogSlot[QUEUE_CAPACITY])
+        , m_enqueuePos(0)
+        , m_dequeuePos(0)
+        , m_running(false)
+        , m_dropped(0)
+        , m_suppressed(0)
+        , m_rateWindow(0)
+        , m_rateCount(0)
+        , m_rateLimit(DEFAULT_RATE_LIMIT)
+    {
+        for (size_t i = 0; i < QUEUE_CAPACITY; ++i)
+            m_slots[i].sequence.store(i, std::memory_order_relaxed);
+    }
+    
+    ~LogBackend()
+    {
+        stop();
+    }
+    
+    void start()
+    {
+        if (m_running.exchange(true))
+            return;
+        m_writer = std::thread(&LogBackend::writerLoop, this);
+    }
+    
+    void stop()
+    {
+        if (!m_running.exchange(false))
+            return;
+        m_wake.notify_one();
+        if (m_writer.joinable())
+            m_writer.join();
+    }
+    
+    bool isRunning() const { return m_running.load(std::memory_order_acquire); }
+    void setRateLimit(int limit) { m_rateLimit.store(limit, std::memory_order_relaxed); }
+    
+    
+    bool admit(LogLevel level)
+    {
+        if (level == LogLevel::Error)
+            return true;
+        
+        int64_t window = std::chrono::duration_cast<std::chrono::seconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+        int64_t current = m_rateWindow.load(std::memory_order_relaxed);
+        if (window != current && m_rateWindow.compare_exchange_strong(current, window))
+            m_rateCount.store(0, std::memory_order_relaxed);
+        
+        if (m_rateCount.fetch_add(1, std::memory_order_relaxed) >= m_rateLimit.load(std::memory_order_relaxed))
+        {
+            m_suppressed.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        return true;
+    }
+    
+    
+    LogSlot* claim(size_t& position)
+    {
+        size_t pos = m_enqueuePos.load(std::memory_order_relaxed);
+        for (;;)
+        {
+            LogSlot& slot = m_slots[pos & (QUEUE_CAPACITY - 1)];
+            size_t sequence = slot.sequence.load(std::memory_order_acquire);
+            intptr_t diff = (intptr_t)sequence - (intptr_t)pos;
+            
+            if (diff == 0)
+            {
+                if (m_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                {
+                    position = pos;
+                    return &slot;
+                }
+            }
+            else if (diff < 0)
+            {
+                m_dropped.fetch_add(1, std::memory_order_relaxed);
+                return nullptr;
+            }
+            else
+            {
+                pos = m_enqueuePos.load(std::memory_order_relaxed);
+            }
+        }
+    }
+    
+    void publish(LogSlot* slot, size_t position)
+    {
+        slot->sequence.store(position + 1, std::memory_order_release);
+        if (slot->level == LogLevel::Error)
+            m_wake.notify_one();
+    }
+    
+private:
+    std::unique_ptr<LogSlot[]> m_slots;
+    std::atomic<size_t> m_enqueuePos;
+    size_t m_dequeuePos;
+    
+    std::atomic<bool> m_running;
+    std::thread m_writer;
+    std::mutex m_wakeMutex;
+    std::condition_variable m_wake;
+    
+    std::atomic<uint64_t> m_dropped;
+    std::atomic<uint64_t> m_suppressed;
+    std::atomic<int64_t> m_rateWindow;
+    std::atomic<int> m_rateCount;
+    std::atomic<int> m_rateLimit;
+    
+    int drain()
+    {
+        int written = 0;
+        for (;;)
+        {
+            LogSlot& slot = m_slots[m_dequeuePos & (QUEUE_CAPACITY - 1)];
+            if (slot.sequence.load(std::memory_order_acquire) != m_dequeuePos + 1)
+                break;
+            
+            writeLine(slot.level, slot.text);
+            slot.sequence.store(m_dequeuePos + QUEUE_CAPACITY, std::memory_order_release);
+            ++m_dequeuePos;
+            ++written;
+        }
+        
+        uint64_t dropped = m_dropped.exchange(0, std::memory_order_relaxed);
+        uint64_t suppressed = m_suppressed.exchange(0, std::memory_order_relaxed);
+        if (dropped > 0 || suppressed > 0)
+        {
+            char line[128];
+            std::snprintf(line, sizeof(line), "Log backlog: %llu messages dropped (queue full), %llu rate limited",
+                          (unsigned long long)dropped, (unsigned long long)suppressed);
+            writeLine(LogLevel::Warning, line);
+            ++written;
+        }
+        
+        if (written > 0)
+        {
+            std::fflush(stdout);
+            std::fflush(stderr);
+        }
+        return written;
+    }
+    
+    void writerLoop()
+    {
+        while (m_running.load(std::memory_order_acquire))
+        {
+            if (drain() == 0)
+            {
+                std::unique_lock<std::mutex> lock(m_wakeMutex);
+                m_wake.wait_for(lock, std::chrono::milliseconds(5));
+            }
+        }
+        drain();
+    }
+};
+
+static LogBackend s_backend;
 
 void Log::init()
 {
+    s_backend.start();
+}
+
+void Log::shutdown()
+{
+    s_backend.stop();
+}
+
+void Log::setRateLimit(int messagesPerSecond)
+{
+    s_backend.setRateLimit(messagesPerSecond);
+}
+
+void Log::write(LogLevel level, const char* message)
+{
+    if (!s_backend.isRunning())
+    {
+        writeLine(level, message);
+        std::fflush(level == LogLevel::Error ? stderr : stdout);
+        return;
+    }
+    
+    if (!s_backend.admit(level))
+        return;
+    
+    size_t position;
+    LogSlot* slot = s_backend.claim(position);
+    if (!slot)
+        return;
+    
+    size_t length = std::min(std::strlen(message), (size_t)MESSAGE_SIZE - 1);
+    slot->level = level;
+    std::memcpy(slot->text, message, length);
+    slot->text[length] = '\0';
+    s_backend.publish(slot, position);
+}
+
+void Log::write(LogLevel level, const std::string& message)
+{
+    write(level, message.c_str());
+}
+
+void Log::writef(LogLevel level, const char* format, ...)
+{
+    va_list args;
+    va_start(args, format);
     
+    if (!s_backend.isRunning())
+    {
+        char text[MESSAGE_SIZE];
+        std::vsnprintf(text, sizeof(text), format, args);
+        va_end(args);
+        writeLine(level, text);
+        std::fflush(level == LogLevel::Error ? stderr : stdout);
+        return;
+    }
     
+    size_t position;
+    LogSlot* slot = s_backend.admit(level) ? s_backend.claim(position) : nullptr;
+    if (slot)
+    {
+        
+        slot->level = level;
+        std::vsnprintf(slot->text, MESSAGE_SIZE, format, args);
+        s_backend.publish(slot, position);
+    }
+    va_end(args);
 }
 
 void Log::info(const std::string& message)
 {
-    std::cout << "[INFO] " << message << std::endl;
+    LOG_INFO(message);
 }
 
 void Log::warning(const std::string& message)
 {
-    std::cout << "[WARNING] " << message << std::endl;
+    LOG_WARNING(message);
 }
 
 void Log::error(const std::string& message)
 {
-    std::cerr << "[ERROR] " << message << std::endl;
+    LOG_ERROR(message);
 }
@@ -2,10 +2,85 @@
 
 #include "../Header/Application.h"
 #include "../Header/Log.h"
+#ifndef KOSTUR_HEADLESS_ONLY
 #include <GLFW/glfw3.h>
+#endif
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
 
-int main()
+static bool parseOptions(int argc, char** argv, HeadlessOptions& options, bool& vsync)
 {
+    bool headless = false;
+    for (int i = 1; i < argc; ++i)
+    {
+        const char* arg = argv[i];
+        const char* value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+        
+        if (std::strcmp(arg, "--headless") == 0)
+        {
+            headless = true;
+        }
+        else if (std::strcmp(arg, "--vsync") == 0)
+        {
+            vsync = true;
+        }
+        else if (std::strcmp(arg, "--cycles") == 0 && value)
+        {
+            options.cycles = std::max(1, std::atoi(value));
+            ++i;
+        }
+        else if (std::strcmp(arg, "--seats") == 0 && value)
+        {
+            options.seatsPerCycle = std::max(1, std::atoi(value));
+            ++i;
+        }
+        else if (std::strcmp(arg, "--timestep") == 0 && value)
+        {
+            float timeStep = (float)std::atof(value);
+            if (timeStep > 0.0f)
+                options.timeStep = timeStep;
+            ++i;
+        }
+        else if (std::strcmp(arg, "--max-time") == 0 && value)
+        {
+            double maxTime = std::atof(value);
+            if (maxTime > 0.0)
+                options.maxSimulatedSeconds = maxTime;
+            ++i;
+        }
+        else
+        {
+            LOG_WARNING(std::string("Ignoring unknown argument: ") + arg);
+        }
+    }
+#ifdef KOSTUR_HEADLESS_ONLY
+    headless = true;
+#endif
+    return headless;
+}
+
+int main(int argc, char** argv)
+{
+    
+    HeadlessOptions headlessOptions;
+    bool vsync = false;
+    if (parseOptions(argc, argv, headlessOptions, vsync))
+    {
+        Application app;
+        if (!app.initHeadless(headlessOptions))
+        {
+            LOG_ERROR("Headless initialization failed!");
+            return -1;
+        }
+        
+        int result = app.runHeadless();
+        app.shutdown();
+        Log::shutdown();
+        return result;
+    }
+    
+#ifndef KOSTUR_HEADLESS_ONLY
     
     if (!glfwInit())
     {
@@ -16,7 +91,7 @@ int main()
     
     Application app;
     
-    if (!app.init())
+    if (!app.init(vsync))
     {
         LOG_ERROR("Application initialization failed!");
         glfwTerminate();
@@ -25,7 +100,9 @@ int main()
 
     app.run();
     app.shutdown();
+    Log::shutdown();
 
     glfwTerminate();
+#endif
     return 0;
 }
@@ -0,0 +1,121 @@
+﻿#include "../Header/MappedFile.h"
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::MappedFile()
+    : m_data(nullptr)
+    , m_size(0)
+#ifdef _WIN32
+    , m_fileHandle(nullptr)
+    , m_mappingHandle(nullptr)
+#endif
+{
+}
+
+MappedFile::~MappedFile()
+{
+    close();
+}
+
+#ifdef _WIN32
+
+bool MappedFile::open(const std::string& path)
+{
+    close();
+
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                              OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+        return false;
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size) || size.QuadPart == 0)
+    {
+        CloseHandle(file);
+        return false;
+    }
+
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!mapping)
+    {
+        CloseHandle(file);
+        return false;
+    }
+
+    void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (!view)
+    {
+        CloseHandle(mapping);
+        CloseHandle(file);
+        return false;
+    }
+
+    m_fileHandle = file;
+    m_mappingHandle = mapping;
+    m_data = static_cast<const unsigned char*>(view);
+    m_size = (size_t)size.QuadPart;
+    return true;
+}
+
+void MappedFile::close()
+{
+    if (m_data)
+        UnmapViewOfFile(m_data);
+    if (m_mappingHandle)
+        CloseHandle((HANDLE)m_mappingHandle);
+    if (m_fileHandle)
+        CloseHandle((HANDLE)m_fileHandle);
+
+    m_data = nullptr;
+    m_size = 0;
+    m_fileHandle = nullptr;
+    m_mappingHandle = nullptr;
+}
+
+#else
+
+bool MappedFile::open(const std::string& path)
+{
+    close();
+
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+        return false;
+
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size == 0)
+    {
+        ::close(fd);
+        return false;
+    }
+
+    void* view = mmap(nullptr, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (view == MAP_FAILED)
+        return false;
+
+    m_data = static_cast<const unsigned char*>(view);
+    m_size = (size_t)info.st_size;
+    return true;
+}
+
+void MappedFile::close()
+{
+    if (m_data)
+        munmap(const_cast<unsigned char*>(m_data), m_size);
+
+    m_data = nullptr;
+    m_size = 0;
+}
+
+#endif
@@ -0,0 +1,157 @@
+﻿#include "../Header/MeshCache.h"
+#include <sys/stat.h>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+static_assert(sizeof(MeshCacheHeader) == 40, "MeshCacheHeader layout must stay stable on disk");
+
+static const char MESH_CACHE_MAGIC[4] = { 'K', 'M', 'S', 'H' };
+
+MeshCache::MeshCache()
+    : m_header(nullptr)
+{
+}
+
+std::string MeshCache::cachePathFor(const std::string& objPath)
+{
+    return objPath + ".meshcache";
+}
+
+bool MeshCache::querySource(const std::string& objPath, uint64_t& size, int64_t& mtime)
+{
+#ifdef _WIN32
+    struct _stat64 info;
+    if (_stat64(objPath.c_str(), &info) != 0)
+        return false;
+#else
+    struct stat info;
+    if (stat(objPath.c_str(), &info) != 0)
+        return false;
+#endif
+    size = (uint64_t)info.st_size;
+    mtime = (int64_t)info.st_mtime;
+    return true;
+}
+
+bool MeshCache::open(const std::string& objPath, int floatsPerVertex)
+{
+    close();
+
+    uint64_t sourceSize;
+    int64_t sourceMtime;
+    if (!querySource(objPath, sourceSize, sourceMtime))
+        return false;
+
+    if (!m_file.open(cachePathFor(objPath)))
+        return false;
+
+    if (m_file.getSize() < sizeof(MeshCacheHeader))
+    {
+        close();
+        return false;
+    }
+
+    const MeshCacheHeader* header = reinterpret_cast<const MeshCacheHeader*>(m_file.getData());
+    size_t expectedSize = sizeof(MeshCacheHeader) +
+                          (size_t)header->vertexCount * header->floatsPerVertex * sizeof(float) +
+                          (size_t)header->indexCount * sizeof(unsigned int);
+
+    if (std::memcmp(header->magic, MESH_CACHE_MAGIC, sizeof(MESH_CACHE_MAGIC)) != 0 ||
+        header->version != VERSION ||
+        header->floatsPerVertex != (uint32_t)floatsPerVertex ||
+        header->vertexCount == 0 ||
+        header->indexCount == 0 ||
+        header->sourceSize != sourceSize ||
+        header->sourceMtime != sourceMtime ||
+        m_file.getSize() != expectedSize)
+    {
+        std::cout << "[INFO] Mesh cache is stale, rebuilding: " << cachePathFor(objPath) << std::endl;
+        close();
+        return false;
+    }
+
+    m_header = header;
+    return true;
+}
+
+void MeshCache::close()
+{
+    m_header = nullptr;
+    m_file.close();
+}
+
+const float* MeshCache::getVertexData() const
+{
+    if (!m_header)
+        return nullptr;
+    return reinterpret_cast<const float*>(m_file.getData() + sizeof(MeshCacheHeader));
+}
+
+int MeshCache::getVertexCount() const
+{
+    return m_header ? (int)m_header->vertexCount : 0;
+}
+
+const unsigned int* MeshCache::getIndexData() const
+{
+    if (!m_header)
+        return nullptr;
+    return reinterpret_cast<const unsigned int*>(m_file.getData() + sizeof(MeshCacheHeader) +
+        (size_t)m_header->vertexCount * m_header->floatsPerVertex * sizeof(float));
+}
+
+int MeshCache::getIndexCount() const
+{
+    return m_header ? (int)m_header->indexCount : 0;
+}
+
+bool MeshCache::write(const std::string& objPath, const ObjMeshData& mesh)
+{
+    MeshCacheHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, MESH_CACHE_MAGIC, sizeof(MESH_CACHE_MAGIC));
+    header.version = VERSION;
+    header.floatsPerVertex = (uint32_t)mesh.floatsPerVertex;
+    header.vertexCount = (uint32_t)mesh.getVertexCount();
+    header.indexCount = (uint32_t)mesh.getIndexCount();
+
+    if (!querySource(objPath, header.sourceSize, header.sourceMtime))
+        return false;
+
+    std::string cachePath = cachePathFor(objPath);
+    std::string tempPath = cachePath + ".tmp";
+
+    {
+        std::ofstream out(tempPath, std::ios::binary | std::ios::trunc);
+        if (!out.is_open())
+        {
+            std::cerr << "[WARNING] Cannot write mesh cache: " << cachePath << std::endl;
+            return false;
+        }
+
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        out.write(reinterpret_cast<const char*>(mesh.vertices.data()),
+                  (std::streamsize)(mesh.vertices.size() * sizeof(float)));
+        out.write(reinterpret_cast<const char*>(mesh.indices.data()),
+                  (std::streamsize)(mesh.indices.size() * sizeof(unsigned int)));
+        if (!out)
+        {
+            std::cerr << "[WARNING] Failed writing mesh cache: " << cachePath << std::endl;
+            out.close();
+            std::remove(tempPath.c_str());
+            return false;
+        }
+    }
+
+    std::remove(cachePath.c_str());
+    if (std::rename(tempPath.c_str(), cachePath.c_str()) != 0)
+    {
+        std::remove(tempPath.c_str());
+        return false;
+    }
+
+    std::cout << "[INFO] Wrote mesh cache: " << cachePath << std::endl;
+    return true;
+}
@@ -0,0 +1,157 @@
+﻿#include "../Header/NavGrid.h"
+#include "../Header/Log.h"
+#include <algorithm>
+#include <cmath>
+
+static const int STEP_X[NavGrid::DIRECTION_COUNT] = { 1, -1, 0, 0, 1, -1, 1, -1 };
+static const int STEP_Z[NavGrid::DIRECTION_COUNT] = { 0, 0, 1, -1, 1, -1, -1, 1 };
+
+NavGrid::NavGrid()
+    : m_origin(0.0f)
+    , m_cellSize(0.5f)
+    , m_floorY(0.0f)
+    , m_width(0)
+    , m_depth(0)
+{
+}
+
+bool NavGrid::build(const AABB& floor, float cellSize,
+                    const std::vector<AABB>& surfaces,
+                    const std::vector<AABB>& obstacles)
+{
+    glm::vec3 extent = floor.size();
+    if (cellSize <= 0.0f || extent.x <= 0.0f || extent.z <= 0.0f)
+    {
+        LOG_ERROR("[NAV] Invalid navigation grid bounds");
+        return false;
+    }
+
+    m_origin = glm::vec2(floor.min.x, floor.min.z);
+    m_cellSize = cellSize;
+    m_floorY = floor.max.y;
+    m_width = (int)std::ceil(extent.x / cellSize);
+    m_depth = (int)std::ceil(extent.z / cellSize);
+
+    m_heights.assign(getCellCount(), m_floorY);
+    m_walkable.assign(getCellCount(), 1);
+
+    
+    for (const AABB& surface : surfaces)
+    {
+        int minX, maxX, minZ, maxZ;
+        if (!cellRange(surface, minX, maxX, minZ, maxZ))
+            continue;
+
+        for (int z = minZ; z <= maxZ; ++z)
+        {
+            for (int x = minX; x <= maxX; ++x)
+            {
+                float& height = m_heights[cellIndex(x, z)];
+                height = std::max(height, surface.max.y);
+            }
+        }
+    }
+
+    for (const AABB& obstacle : obstacles)
+    {
+        int minX, maxX, minZ, maxZ;
+        if (!cellRange(obstacle, minX, maxX, minZ, maxZ))
+            continue;
+
+        for (int z = minZ; z <= maxZ; ++z)
+        {
+            for (int x = minX; x <= maxX; ++x)
+                m_walkable[cellIndex(x, z)] = 0;
+        }
+    }
+
+    buildLinks();
+
+    LOG_INFO("[NAV] Built " + std::to_string(m_width) + "x" + std::to_string(m_depth) + " navigation grid");
+    return true;
+}
+
+bool NavGrid::contains(int cellX, int cellZ) const
+{
+    return cellX >= 0 && cellX < m_width && cellZ >= 0 && cellZ < m_depth;
+}
+
+int NavGrid::cellAt(const glm::vec3& position) const
+{
+    int x = (int)std::floor((position.x - m_origin.x) / m_cellSize);
+    int z = (int)std::floor((position.z - m_origin.y) / m_cellSize);
+    x = std::min(std::max(x, 0), m_width - 1);
+    z = std::min(std::max(z, 0), m_depth - 1);
+    return cellIndex(x, z);
+}
+
+glm::vec3 NavGrid::cellCenter(int index) const
+{
+    return glm::vec3(m_origin.x + (cellX(index) + 0.5f) * m_cellSize,
+                     m_heights.empty() ? m_floorY : m_heights[index],
+                     m_origin.y + (cellZ(index) + 0.5f) * m_cellSize);
+}
+
+float NavGrid::heightAt(const glm::vec3& position) const
+{
+    if (m_heights.empty())
+        return m_floorY;
+    return m_heights[cellAt(position)];
+}
+
+bool NavGrid::canStep(int from, int to) const
+{
+    if (!m_walkable[from] || !m_walkable[to])
+        return false;
+    return std::abs(m_heights[to] - m_heights[from]) <= MAX_STEP_HEIGHT;
+}
+
+int NavGrid::neighbour(int index, int direction) const
+{
+    return cellIndex(cellX(index) + STEP_X[direction], cellZ(index) + STEP_Z[direction]);
+}
+
+void NavGrid::buildLinks()
+{
+    m_links.assign(getCellCount(), 0);
+
+    for (int index = 0; index < getCellCount(); ++index)
+    {
+        int x = cellX(index);
+        int z = cellZ(index);
+
+        for (int d = 0; d < DIRECTION_COUNT; ++d)
+        {
+            int nx = x + STEP_X[d];
+            int nz = z + STEP_Z[d];
+            if (!contains(nx, nz))
+                continue;
+
+            int target = cellIndex(nx, nz);
+            if (!canStep(index, target))
+                continue;
+
+            
+            if (STEP_X[d] != 0 && STEP_Z[d] != 0)
+            {
+                int sideX = cellIndex(nx, z);
+                int sideZ = cellIndex(x, nz);
+                if (!canStep(index, sideX) || !canStep(sideX, target) ||
+                    !canStep(index, sideZ) || !canStep(sideZ, target))
+                    continue;
+            }
+
+            m_links[index] |= (uint8_t)(1 << d);
+        }
+    }
+}
+
+bool NavGrid::cellRange(const AABB& bounds, int& minX, int& maxX, int& minZ, int& maxZ) const
+{
+    
+    minX = std::max((int)std::ceil((bounds.min.x - m_origin.x) / m_cellSize - 0.5f), 0);
+    maxX = std::min((int)std::floor((bounds.max.x - m_origin.x) / m_cellSize - 0.5f), m_width - 1);
+    minZ = std::max((int)std::ceil((bounds.min.z - m_origin.y) / m_cellSize - 0.5f), 0);
+    maxZ = std::min((int)std::floor((bounds.max.z - m_origin.y) / m_cellSize - 0.5f), m_depth - 1);
+    return minX <= maxX && minZ <= maxZ;
+}
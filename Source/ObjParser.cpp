@@ -0,0 +1,486 @@
+﻿#include "../Header/ObjParser.h"
+#include "../Header/MappedFile.h"
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <limits>
+#include <unordered_map>
+
+struct ObjVertexKey
+{
+    int position;
+    int texCoord;
+    int normal;
+
+    bool operator==(const ObjVertexKey& other) const
+    {
+        return position == other.position && texCoord == other.texCoord && normal == other.normal;
+    }
+};
+
+struct ObjVertexKeyHash
+{
+    size_t operator()(const ObjVertexKey& key) const
+    {
+        uint64_t h = (uint64_t)(uint32_t)key.position * 0x9E3779B97F4A7C15ull;
+        h ^= (uint64_t)(uint32_t)key.texCoord * 0xC2B2AE3D27D4EB4Full + (h << 6) + (h >> 2);
+        h ^= (uint64_t)(uint32_t)key.normal * 0x165667B19E3779F9ull + (h << 6) + (h >> 2);
+        return (size_t)h;
+    }
+};
+
+static const double POW10[] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+static inline bool isDigit(char c)
+{
+    return c >= '0' && c <= '9';
+}
+
+static inline const char* skipBlanks(const char* p, const char* end)
+{
+    while (p < end && (*p == ' ' || *p == '\t'))
+        ++p;
+    return p;
+}
+
+static inline const char* skipLine(const char* p, const char* end)
+{
+    while (p < end && *p != '\n')
+        ++p;
+    return p < end ? p + 1 : end;
+}
+
+static double scaleByPow10(double value, int exponent)
+{
+    while (exponent > 22)
+    {
+        value *= 1e22;
+        exponent -= 22;
+    }
+    while (exponent < -22)
+    {
+        value /= 1e22;
+        exponent += 22;
+    }
+    return exponent >= 0 ? value * POW10[exponent] : value / POW10[-exponent];
+}
+
+static const char* parseFloat(const char* p, const char* end, float& out)
+{
+    p = skipBlanks(p, end);
+
+    bool negative = false;
+    if (p < end && (*p == '-' || *p == '+'))
+    {
+        negative = (*p == '-');
+        ++p;
+    }
+
+    uint64_t mantissa = 0;
+    int exponent = 0;
+    int digits = 0;
+
+    while (p < end && isDigit(*p))
+    {
+        if (digits < 19)
+            mantissa = mantissa * 10 + (uint64_t)(*p - '0');
+        else
+            ++exponent;
+        ++digits;
+        ++p;
+    }
+
+    if (p < end && *p == '.')
+    {
+        ++p;
+        while (p < end && isDigit(*p))
+        {
+            if (digits < 19)
+            {
+                mantissa = mantissa * 10 + (uint64_t)(*p - '0');
+                --exponent;
+            }
+            ++digits;
+            ++p;
+        }
+    }
+
+    if (digits == 0)
+        return nullptr;
+
+    if (p < end && (*p == 'e' || *p == 'E'))
+    {
+        const char* expStart = p++;
+        bool expNegative = false;
+        if (p < end && (*p == '-' || *p == '+'))
+        {
+            expNegative = (*p == '-');
+            ++p;
+        }
+
+        if (p < end && isDigit(*p))
+        {
+            int expValue = 0;
+            while (p < end && isDigit(*p))
+            {
+                if (expValue < 10000)
+                    expValue = expValue * 10 + (*p - '0');
+                ++p;
+            }
+            exponent += expNegative ? -expValue : expValue;
+        }
+        else
+        {
+            p = expStart;
+        }
+    }
+
+    double value = scaleByPow10((double)mantissa, exponent);
+    out = (float)(negative ? -value : value);
+    return p;
+}
+
+static const char* parseInt(const char* p, const char* end, int& out)
+{
+    bool negative = false;
+    if (p < end && (*p == '-' || *p == '+'))
+    {
+        negative = (*p == '-');
+        ++p;
+    }
+
+    if (p >= end || !isDigit(*p))
+        return nullptr;
+
+    int value = 0;
+    while (p < end && isDigit(*p))
+    {
+        value = value * 10 + (*p - '0');
+        ++p;
+    }
+
+    out = negative ? -value : value;
+    return p;
+}
+
+static int resolveIndex(int index, int count)
+{
+    if (index > 0)
+        return index <= count ? index - 1 : -1;
+    if (index < 0)
+        return count + index >= 0 ? count + index : -1;
+    return -1;
+}
+
+bool ObjParser::loadFile(const std::string& path, bool withTexCoords, ObjMeshData& mesh)
+{
+    MappedFile file;
+    if (!file.open(path))
+    {
+        std::cerr << "[ERROR] Cannot open OBJ: " << path << std::endl;
+        return false;
+    }
+
+    if (!parse(reinterpret_cast<const char*>(file.getData()), file.getSize(), withTexCoords, mesh))
+    {
+        std::cerr << "[ERROR] OBJ produced 0 vertices: " << path << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+bool ObjParser::parse(const char* text, size_t length, bool withTexCoords, ObjMeshData& mesh)
+{
+    const char* p = text;
+    const char* end = text + length;
+
+    std::vector<float> positions;
+    std::vector<float> normals;
+    std::vector<float> texCoords;
+
+    
+    size_t estimatedLines = length / 32;
+    positions.reserve(estimatedLines);
+    normals.reserve(estimatedLines);
+    if (withTexCoords)
+        texCoords.reserve(estimatedLines);
+
+    const int floatsPerVertex = withTexCoords ? 8 : 6;
+    mesh.floatsPerVertex = floatsPerVertex;
+    mesh.vertices.clear();
+    mesh.indices.clear();
+    mesh.vertices.reserve(estimatedLines * floatsPerVertex / 2);
+    mesh.indices.reserve(estimatedLines * 2);
+
+    std::unordered_map<ObjVertexKey, unsigned int, ObjVertexKeyHash> vertexLookup;
+    vertexLookup.reserve(estimatedLines / 2);
+
+    std::vector<bool> missingNormal;
+    bool anyMissingNormal = false;
+
+    std::vector<unsigned int> polygon;
+    int skippedFaces = 0;
+
+    while (p < end)
+    {
+        p = skipBlanks(p, end);
+        if (p >= end)
+            break;
+
+        if (p[0] == 'v' && p + 1 < end && (p[1] == ' ' || p[1] == '\t'))
+        {
+            float x = 0.0f, y = 0.0f, z = 0.0f;
+            const char* q = parseFloat(p + 1, end, x);
+            if (q) q = parseFloat(q, end, y);
+            if (q) q = parseFloat(q, end, z);
+            if (q)
+            {
+                positions.push_back(x);
+                positions.push_back(y);
+                positions.push_back(z);
+            }
+        }
+        else if (p[0] == 'v' && p + 1 < end && p[1] == 'n')
+        {
+            float x = 0.0f, y = 0.0f, z = 0.0f;
+            const char* q = parseFloat(p + 2, end, x);
+            if (q) q = parseFloat(q, end, y);
+            if (q) q = parseFloat(q, end, z);
+            if (q)
+            {
+                normals.push_back(x);
+                normals.push_back(y);
+                normals.push_back(z);
+            }
+        }
+        else if (p[0] == 'v' && p + 1 < end && p[1] == 't')
+        {
+            if (withTexCoords)
+            {
+                float u = 0.0f, v = 0.0f;
+                const char* q = parseFloat(p + 2, end, u);
+                if (q) q = parseFloat(q, end, v);
+                if (q)
+                {
+                    texCoords.push_back(u);
+                    texCoords.push_back(v);
+                }
+            }
+        }
+        else if (p[0] == 'f' && p + 1 < end && (p[1] == ' ' || p[1] == '\t'))
+        {
+            const int positionCount = (int)(positions.size() / 3);
+            const int normalCount = (int)(normals.size() / 3);
+            const int texCoordCount = (int)(texCoords.size() / 2);
+
+            polygon.clear();
+            bool valid = true;
+            const char* q = p + 1;
+
+            while (true)
+            {
+                q = skipBlanks(q, end);
+                if (q >= end || *q == '\n' || *q == '\r' || *q == '#')
+                    break;
+
+                int v = 0, t = 0, n = 0;
+                q = parseInt(q, end, v);
+                if (!q)
+                {
+                    valid = false;
+                    break;
+                }
+
+                if (q < end && *q == '/')
+                {
+                    ++q;
+                    if (q < end && *q != '/')
+                    {
+                        const char* r = parseInt(q, end, t);
+                        if (r) q = r;
+                    }
+                    if (q < end && *q == '/')
+                    {
+                        ++q;
+                        const char* r = parseInt(q, end, n);
+                        if (r) q = r;
+                    }
+                }
+
+                ObjVertexKey key;
+                key.position = resolveIndex(v, positionCount);
+                key.texCoord = withTexCoords ? resolveIndex(t, texCoordCount) : -1;
+                key.normal = resolveIndex(n, normalCount);
+
+                if (key.position < 0)
+                {
+                    valid = false;
+                    break;
+                }
+
+                auto inserted = vertexLookup.emplace(key, (unsigned int)(mesh.vertices.size() / floatsPerVertex));
+                if (inserted.second)
+                {
+                    mesh.vertices.push_back(positions[key.position * 3 + 0]);
+                    mesh.vertices.push_back(positions[key.position * 3 + 1]);
+                    mesh.vertices.push_back(positions[key.position * 3 + 2]);
+
+                    if (key.normal >= 0)
+                    {
+                        mesh.vertices.push_back(normals[key.normal * 3 + 0]);
+                        mesh.vertices.push_back(normals[key.normal * 3 + 1]);
+                        mesh.vertices.push_back(normals[key.normal * 3 + 2]);
+                    }
+                    else
+                    {
+                        mesh.vertices.push_back(0.0f);
+                        mesh.vertices.push_back(0.0f);
+                        mesh.vertices.push_back(0.0f);
+                        anyMissingNormal = true;
+                    }
+                    missingNormal.push_back(key.normal < 0);
+
+                    if (withTexCoords)
+                    {
+                        mesh.vertices.push_back(key.texCoord >= 0 ? texCoords[key.texCoord * 2 + 0] : 0.0f);
+                        mesh.vertices.push_back(key.texCoord >= 0 ? texCoords[key.texCoord * 2 + 1] : 0.0f);
+                    }
+                }
+
+                polygon.push_back(inserted.first->second);
+            }
+
+            if (valid && polygon.size() >= 3)
+            {
+                
+                for (size_t i = 1; i + 1 < polygon.size(); ++i)
+                {
+                    mesh.indices.push_back(polygon[0]);
+                    mesh.indices.push_back(polygon[i]);
+                    mesh.indices.push_back(polygon[i + 1]);
+                }
+            }
+            else
+            {
+                ++skippedFaces;
+            }
+        }
+
+        p = skipLine(p, end);
+    }
+
+    if (skippedFaces > 0)
+    {
+        std::cout << "[WARNING] OBJ parser skipped " << skippedFaces << " malformed faces" << std::endl;
+    }
+
+    if (anyMissingNormal)
+    {
+        
+        for (size_t i = 0; i + 2 < mesh.indices.size(); i += 3)
+        {
+            unsigned int a = mesh.indices[i + 0];
+            unsigned int b = mesh.indices[i + 1];
+            unsigned int c = mesh.indices[i + 2];
+
+            const float* pa = &mesh.vertices[a * floatsPerVertex];
+            const float* pb = &mesh.vertices[b * floatsPerVertex];
+            const float* pc = &mesh.vertices[c * floatsPerVertex];
+
+            float e1x = pb[0] - pa[0], e1y = pb[1] - pa[1], e1z = pb[2] - pa[2];
+            float e2x = pc[0] - pa[0], e2y = pc[1] - pa[1], e2z = pc[2] - pa[2];
+            float nx = e1y * e2z - e1z * e2y;
+            float ny = e1z * e2x - e1x * e2z;
+            float nz = e1x * e2y - e1y * e2x;
+
+            unsigned int corners[3] = { a, b, c };
+            for (unsigned int corner : corners)
+            {
+                if (!missingNormal[corner])
+                    continue;
+                float* n = &mesh.vertices[corner * floatsPerVertex + 3];
+                n[0] += nx;
+                n[1] += ny;
+                n[2] += nz;
+            }
+        }
+
+        int vertexCount = mesh.getVertexCount();
+        for (int i = 0; i < vertexCount; ++i)
+        {
+            if (!missingNormal[i])
+                continue;
+            float* n = &mesh.vertices[i * floatsPerVertex + 3];
+            float len = std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+            if (len > 1e-12f)
+            {
+                n[0] /= len;
+                n[1] /= len;
+                n[2] /= len;
+            }
+            else
+            {
+                n[0] = 0.0f;
+                n[1] = 1.0f;
+                n[2] = 0.0f;
+            }
+        }
+    }
+
+    return !mesh.indices.empty();
+}
+
+void ObjParser::normalizeToUnitSize(ObjMeshData& mesh)
+{
+    const int vertexCount = mesh.getVertexCount();
+    const int stride = mesh.floatsPerVertex;
+    if (vertexCount == 0)
+        return;
+
+    float minX =  (std::numeric_limits<float>::max)();
+    float minY =  (std::numeric_limits<float>::max)();
+    float minZ =  (std::numeric_limits<float>::max)();
+    float maxX = -(std::numeric_limits<float>::max)();
+    float maxY = -(std::numeric_limits<float>::max)();
+    float maxZ = -(std::numeric_limits<float>::max)();
+
+    for (int i = 0; i < vertexCount; ++i)
+    {
+        const float* v = &mesh.vertices[i * stride];
+        if (v[0] < minX)
+            minX = v[0];
+        if (v[0] > maxX)
+            maxX = v[0];
+        if (v[1] < minY)
+            minY = v[1];
+        if (v[1] > maxY)
+            maxY = v[1];
+        if (v[2] < minZ)
+            minZ = v[2];
+        if (v[2] > maxZ)
+            maxZ = v[2];
+    }
+
+    float cx = (minX + maxX) * 0.5f;
+    float cy = (minY + maxY) * 0.5f;
+    float cz = (minZ + maxZ) * 0.5f;
+
+    float maxSpan = maxX - minX;
+    if (maxY - minY > maxSpan) maxSpan = maxY - minY;
+    if (maxZ - minZ > maxSpan) maxSpan = maxZ - minZ;
+    if (maxSpan < 0.0001f) maxSpan = 1.0f;
+
+    float invSpan = 1.0f / maxSpan;
+
+    for (int i = 0; i < vertexCount; ++i)
+    {
+        float* v = &mesh.vertices[i * stride];
+        v[0] = (v[0] - cx) * invSpan;
+        v[1] = (v[1] - cy) * invSpan;
+        v[2] = (v[2] - cz) * invSpan;
+    }
+}
@@ -1,22 +1,29 @@
 ﻿#include "../Header/PeopleManager.h"
 #include "../Header/SeatGrid.h"
 #include "../Header/Seat.h"
+#ifndef KOSTUR_HEADLESS_ONLY
 #include "../Header/DebugCube.h"
 #include "../Header/HumanMesh.h"
+#include "../Header/CrowdRenderer.h"
 #include "../Shader.h"
+#endif
 #include <glm/gtc/matrix_transform.hpp>
 #include <algorithm>
+#include <cmath>
 #include <random>
 #include <ctime>
 
 PeopleManager::PeopleManager()
-    : m_humanMesh(nullptr)
+    : m_jobSystem(nullptr)
+#ifndef KOSTUR_HEADLESS_ONLY
+    , m_humanMesh(nullptr)
     , m_humanShader(nullptr)
-    , m_doorPos(0.0f)
-    , m_spawnTimer(0.0f)
+    , m_crowdShader(nullptr)
+#endif
 {
 }
 
+#ifndef KOSTUR_HEADLESS_ONLY
 void PeopleManager::setHumanMesh(HumanMesh* mesh)
 {
     m_humanMesh = mesh;
@@ -27,6 +34,23 @@ void PeopleManager::setHumanShader(Shader* shader)
     m_humanShader = shader;
 }
 
+void PeopleManager::setCrowdShader(Shader* shader)
+{
+    m_crowdShader = shader;
+    m_crowdRenderer.reset();
+}
+#endif
+
+void PeopleManager::setJobSystem(JobSystem* jobs)
+{
+    m_jobSystem = jobs;
+}
+
+void PeopleManager::setNavigation(const HallNavigation* navigation)
+{
+    m_crowd.setNavigation(navigation);
+}
+
 PeopleManager::~PeopleManager()
 {
 }
@@ -37,22 +61,8 @@ void PeopleManager::spawnPeople(int count, SeatGrid& grid, const glm::vec3& door
         return;
     
     
-    m_doorPos = doorPos;
-    
-    
-    std::vector<Seat*> occupiedSeats;
-    
-    for (int row = 0; row < SeatGrid::ROWS; ++row)
-    {
-        for (int col = 0; col < SeatGrid::COLS; ++col)
-        {
-            Seat* seat = grid.getSeat(row, col);
-            if (seat && (seat->state == SeatState::Reserved || seat->state == SeatState::Purchased))
-            {
-                occupiedSeats.push_back(seat);
-            }
-        }
-    }
+    std::vector<int> occupiedSeats;
+    grid.getOccupiedSeats(occupiedSeats);
     
     if (occupiedSeats.empty())
         return;
@@ -66,43 +76,30 @@ void PeopleManager::spawnPeople(int count, SeatGrid& grid, const glm::vec3& door
     
     
     
-    m_spawnQueue.clear();
+    m_crowd.clearSpawnQueue();
+    m_crowd.reserve(m_crowd.size() + count);
     
-    int textureCount = (m_humanMesh && m_humanMesh->getTextureCount() > 0) ? m_humanMesh->getTextureCount() : 1;
+    int textureCount = 1;
+#ifndef KOSTUR_HEADLESS_ONLY
+    if (m_humanMesh && m_humanMesh->getTextureCount() > 0)
+        textureCount = m_humanMesh->getTextureCount();
+#endif
     std::uniform_int_distribution<int> textureDist(0, textureCount - 1);
     
     for (int i = 0; i < count; ++i)
     {
-        Seat* targetSeat = occupiedSeats[i];
+        int seatIndex = occupiedSeats[i];
         glm::vec3 color = generateRandomColor();
         int textureIndex = textureDist(rng);
         
-        SpawnRequest req;
-        req.targetSeat = targetSeat;
-        req.color = color;
-        req.textureIndex = textureIndex;
-        m_spawnQueue.push_back(req);
+        m_crowd.queueSpawn(doorPos, grid.getSeatPosition(seatIndex), color, textureIndex);
     }
-    
-    
-    m_spawnTimer = 0.0f;
 }
 
 void PeopleManager::spawnPeopleRandom(SeatGrid& grid, const glm::vec3& doorPos, int minCount, int maxCount)
 {
     
-    int occupiedCount = 0;
-    for (int row = 0; row < SeatGrid::ROWS; ++row)
-    {
-        for (int col = 0; col < SeatGrid::COLS; ++col)
-        {
-            Seat* seat = grid.getSeat(row, col);
-            if (seat && (seat->state == SeatState::Reserved || seat->state == SeatState::Purchased))
-            {
-                occupiedCount++;
-            }
-        }
-    }
+    int occupiedCount = grid.countOccupiedSeats();
     
     if (occupiedCount == 0)
         return;
@@ -117,146 +114,136 @@ void PeopleManager::spawnPeopleRandom(SeatGrid& grid, const glm::vec3& doorPos,
 
 void PeopleManager::clear()
 {
-    m_people.clear();
-    m_spawnQueue.clear();
-    m_spawnTimer = 0.0f;
+    m_crowd.clear();
 }
 
 void PeopleManager::update(float deltaTime)
 {
     
-    if (!m_spawnQueue.empty())
-    {
-        m_spawnTimer += deltaTime;
-        
-        if (m_spawnTimer >= SPAWN_INTERVAL)
-        {
-            
-            SpawnRequest req = m_spawnQueue.front();
-            m_spawnQueue.erase(m_spawnQueue.begin());
-            
-            m_people.push_back(std::make_unique<Person>(m_doorPos, req.targetSeat, req.color, req.textureIndex));
-            
-            
-            m_spawnTimer = 0.0f;
-        }
-    }
-    
-    
-    for (auto& person : m_people)
-    {
-        person->update(deltaTime);
-    }
+    m_crowd.update(deltaTime, m_jobSystem);
 }
 
-void PeopleManager::draw(Shader& phongShader, const glm::mat4& view, const glm::mat4& projection, 
-                         const glm::vec3& viewPos, DebugCube& cubeMesh)
+#ifndef KOSTUR_HEADLESS_ONLY
+void PeopleManager::draw(Shader& phongShader, DebugCube& cubeMesh, float interpolation)
 {
-    if (m_humanMesh && m_humanShader)
+    if (m_humanMesh && m_crowdShader)
+    {
+        drawInstanced(interpolation);
+    }
+    else if (m_humanMesh && m_humanShader)
     {
         m_humanShader->use();
-        m_humanShader->setMat4("view", view);
-        m_humanShader->setMat4("projection", projection);
-        m_humanShader->setVec3("viewPos", viewPos);
-        
+        GLint modelLoc = m_humanShader->uniformLocation("model");
         
-        m_humanShader->setVec3("lightPos", glm::vec3(0.0f, 4.0f, 0.0f));
-        m_humanShader->setVec3("lightColor", glm::vec3(1.0f, 0.95f, 0.85f));
-        m_humanShader->setFloat("lightIntensity", 5.0f);
-        glUniform1i(glGetUniformLocation(m_humanShader->ID, "lightEnabled"), 1);
         
         
+        GLint layerLoc = m_humanShader->uniformLocation("uLayer");
         
         glActiveTexture(GL_TEXTURE0);
-        m_humanShader->setInt("uTexture", 0);
+        glBindTexture(GL_TEXTURE_2D_ARRAY, m_humanMesh->getTextureArrayID());
+        m_humanShader->setInt("uTextures", 0);
+        
+        const std::vector<int>& layers = m_crowd.getTextureIndices();
         
-        for (const auto& person : m_people)
+        for (int i = 0; i < m_crowd.size(); ++i)
         {
-            glm::vec3 pos = person->getPosition();
-            float rotY = person->getRotationY();
-            int texIndex = person->getTextureIndex();
+            glm::vec3 pos = m_crowd.getInterpolatedPosition(i, interpolation);
+            float rotY = m_crowd.getInterpolatedRotation(i, interpolation);
             
-            GLuint texID = m_humanMesh->getTextureID(texIndex);
-            glBindTexture(GL_TEXTURE_2D, texID);
+            m_humanShader->setFloat(layerLoc, (float)layers[i]);
             
             glm::mat4 model = glm::mat4(1.0f);
             model = glm::translate(model, pos);
             model = glm::rotate(model, rotY, glm::vec3(0.0f, 1.0f, 0.0f));
             model = glm::scale(model, glm::vec3(PERSON_WIDTH, PERSON_HEIGHT, PERSON_DEPTH));
             
-            m_humanShader->setMat4("model", model);
+            m_humanShader->setMat4(modelLoc, model);
             
             m_humanMesh->draw();
         }
         
-        glBindTexture(GL_TEXTURE_2D, 0);
+        glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
     }
     else
     {
         
         phongShader.use();
-        phongShader.setMat4("view", view);
-        phongShader.setMat4("projection", projection);
-        phongShader.setVec3("viewPos", viewPos);
+        GLint modelLoc = phongShader.uniformLocation("model");
+        GLint colorLoc = phongShader.uniformLocation("uBaseColor");
         
-        phongShader.setVec3("lightPos", glm::vec3(0.0f, 4.0f, 0.0f));
-        phongShader.setVec3("lightColor", glm::vec3(1.0f, 0.95f, 0.85f));
-        phongShader.setFloat("lightIntensity", 5.0f);
-        glUniform1i(glGetUniformLocation(phongShader.ID, "lightEnabled"), 1);
+        const std::vector<glm::vec3>& colors = m_crowd.getColors();
         
-        for (const auto& person : m_people)
+        for (int i = 0; i < m_crowd.size(); ++i)
         {
-            glm::vec3 pos = person->getPosition();
-            glm::vec3 color = person->getColor();
-            float rotY = person->getRotationY();
+            glm::vec3 pos = m_crowd.getInterpolatedPosition(i, interpolation);
+            const glm::vec3& color = colors[i];
+            float rotY = m_crowd.getInterpolatedRotation(i, interpolation);
             
             glm::mat4 model = glm::mat4(1.0f);
             model = glm::translate(model, pos);
             model = glm::rotate(model, rotY, glm::vec3(0.0f, 1.0f, 0.0f));
             model = glm::scale(model, glm::vec3(PERSON_WIDTH, PERSON_HEIGHT, PERSON_DEPTH));
             
-            phongShader.setMat4("model", model);
-            phongShader.setVec3("uBaseColor", color);
+            phongShader.setMat4(modelLoc, model);
+            phongShader.setVec3(colorLoc, color);
             
             cubeMesh.draw();
         }
     }
 }
+#endif
 
-bool PeopleManager::allSeated() const
+void PeopleManager::getBounds(std::vector<AABB>& bounds) const
 {
-    if (m_people.empty())
-        return false;
+    const std::vector<glm::vec3>& positions = m_crowd.getPositions();
+    const std::vector<float>& rotations = m_crowd.getRotations();
+    bounds.resize(positions.size());
     
-    for (const auto& person : m_people)
+    
+    for (size_t i = 0; i < positions.size(); ++i)
     {
-        if (!person->isSeated())
-            return false;
+        float c = std::fabs(std::cos(rotations[i]));
+        float s = std::fabs(std::sin(rotations[i]));
+        glm::vec3 halfExtents(0.5f * (PERSON_WIDTH * c + PERSON_DEPTH * s),
+                              0.5f * PERSON_HEIGHT,
+                              0.5f * (PERSON_WIDTH * s + PERSON_DEPTH * c));
+        bounds[i] = AABB(positions[i] - halfExtents, positions[i] + halfExtents);
     }
-    
-    return true;
 }
 
-bool PeopleManager::allExited() const
+#ifndef KOSTUR_HEADLESS_ONLY
+void PeopleManager::drawInstanced(float interpolation)
 {
-    if (m_people.empty())
-        return true;  
+    if (m_crowd.size() == 0)
+        return;
+    
+    if (!m_crowdRenderer)
+    {
+        m_crowdRenderer = std::unique_ptr<CrowdRenderer>(new CrowdRenderer());
+        m_crowdRenderer->init(m_humanMesh, m_crowdShader);
+    }
     
-    for (const auto& person : m_people)
+    int count = m_crowd.size();
+    CrowdInstance* instances = m_crowdRenderer->beginFrame(count);
+    if (!instances)
+        return;
+    
+    const std::vector<int>& layers = m_crowd.getTextureIndices();
+    
+    for (int i = 0; i < count; ++i)
     {
-        if (!person->isExited())
-            return false;
+        instances[i].positionRotation = glm::vec4(m_crowd.getInterpolatedPosition(i, interpolation),
+                                                  m_crowd.getInterpolatedRotation(i, interpolation));
+        instances[i].layer = (float)layers[i];
     }
     
-    return true;
+    m_crowdRenderer->draw(count, glm::vec3(PERSON_WIDTH, PERSON_HEIGHT, PERSON_DEPTH));
 }
+#endif
 
 void PeopleManager::startExiting()
 {
-    for (auto& person : m_people)
-    {
-        person->startExiting();
-    }
+    m_crowd.startExiting();
 }
 
 glm::vec3 PeopleManager::generateRandomColor() const
@@ -0,0 +1,49 @@
+﻿#include "../Header/PixelUploadBuffer.h"
+#include <GL/glew.h>
+#include <cstring>
+
+PixelUploadBuffer::PixelUploadBuffer()
+    : m_PBO(0)
+{
+}
+
+PixelUploadBuffer::~PixelUploadBuffer()
+{
+    cleanup();
+}
+
+const void* PixelUploadBuffer::stage(const void* pixels, size_t byteSize)
+{
+    if (m_PBO == 0)
+        glGenBuffers(1, &m_PBO);
+
+    
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, m_PBO);
+    glBufferData(GL_PIXEL_UNPACK_BUFFER, (GLsizeiptr)byteSize, nullptr, GL_STREAM_DRAW);
+
+    void* mapped = glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, (GLsizeiptr)byteSize,
+                                    GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+    if (!mapped)
+    {
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        return pixels;
+    }
+
+    std::memcpy(mapped, pixels, byteSize);
+    glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+    return nullptr;
+}
+
+void PixelUploadBuffer::finish()
+{
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+}
+
+void PixelUploadBuffer::cleanup()
+{
+    if (m_PBO)
+    {
+        glDeleteBuffers(1, &m_PBO);
+        m_PBO = 0;
+    }
+}
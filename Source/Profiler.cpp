@@ -0,0 +1,199 @@
+﻿#include "../Header/Profiler.h"
+#include "../Header/Log.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+
+std::vector<Profiler::OpenZone> Profiler::s_stack;
+std::vector<Profiler::ZoneSeries> Profiler::s_series;
+std::vector<Profiler::TraceEvent> Profiler::s_events;
+std::string Profiler::s_capturePath;
+int Profiler::s_captureFramesLeft = 0;
+int64_t Profiler::s_frameStart = 0;
+
+static const char* FRAME_ZONE = "Frame";
+
+int64_t Profiler::now()
+{
+    static const std::chrono::steady_clock::time_point epoch = std::chrono::steady_clock::now();
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - epoch).count();
+}
+
+void Profiler::beginFrame()
+{
+    s_stack.clear();
+    s_frameStart = now();
+}
+
+void Profiler::endFrame()
+{
+    int64_t end = now();
+    
+    if (s_captureFramesLeft > 0)
+    {
+        TraceEvent event = { FRAME_ZONE, s_frameStart, end - s_frameStart, false };
+        s_events.push_back(event);
+    }
+    
+    
+    pushSample(findSeries(FRAME_ZONE, false), (end - s_frameStart) / 1.0e6);
+    for (ZoneSeries& series : s_series)
+    {
+        if (series.gpu || series.name == FRAME_ZONE)
+            continue;
+        pushSample(series, series.frameTotal);
+        series.frameTotal = 0.0;
+    }
+    
+    if (s_captureFramesLeft > 0 && --s_captureFramesLeft == 0)
+    {
+        finishCapture();
+    }
+}
+
+void Profiler::beginZone(const char* name)
+{
+    OpenZone zone = { name, now() };
+    s_stack.push_back(zone);
+}
+
+void Profiler::endZone()
+{
+    if (s_stack.empty())
+        return;
+    
+    OpenZone zone = s_stack.back();
+    s_stack.pop_back();
+    int64_t duration = now() - zone.start;
+    
+    findSeries(zone.name, false).frameTotal += duration / 1.0e6;
+    
+    if (s_captureFramesLeft > 0)
+    {
+        TraceEvent event = { zone.name, zone.start, duration, false };
+        s_events.push_back(event);
+    }
+}
+
+void Profiler::recordGpuZone(const char* name, int64_t cpuStartNs, double milliseconds)
+{
+    pushSample(findSeries(name, true), milliseconds);
+    
+    if (s_captureFramesLeft > 0)
+    {
+        TraceEvent event = { name, cpuStartNs, (int64_t)(milliseconds * 1.0e6), true };
+        s_events.push_back(event);
+    }
+}
+
+void Profiler::startCapture(const std::string& path, int frames)
+{
+    if (frames <= 0 || s_captureFramesLeft > 0)
+        return;
+    
+    s_capturePath = path;
+    s_captureFramesLeft = frames;
+    s_events.clear();
+    s_events.reserve(frames * 32);
+    LOG_INFO("[PROFILE] Capturing " + std::to_string(frames) + " frames to " + path);
+}
+
+Profiler::ZoneSeries& Profiler::findSeries(const char* name, bool gpu)
+{
+    
+    for (ZoneSeries& series : s_series)
+    {
+        if (series.gpu == gpu && (series.name == name || std::strcmp(series.name, name) == 0))
+            return series;
+    }
+    
+    ZoneSeries series;
+    series.name = name;
+    series.gpu = gpu;
+    series.frameTotal = 0.0;
+    series.samples.assign(WINDOW_FRAMES, 0.0f);
+    series.next = 0;
+    series.count = 0;
+    s_series.push_back(series);
+    return s_series.back();
+}
+
+void Profiler::pushSample(ZoneSeries& series, double milliseconds)
+{
+    series.samples[series.next] = (float)milliseconds;
+    series.next = (series.next + 1) % WINDOW_FRAMES;
+    series.count = std::min(series.count + 1, (int)WINDOW_FRAMES);
+}
+
+std::vector<ProfileStats> Profiler::getStats()
+{
+    std::vector<ProfileStats> result;
+    std::vector<float> sorted;
+    
+    for (const ZoneSeries& series : s_series)
+    {
+        if (series.count == 0)
+            continue;
+        
+        sorted.assign(series.samples.begin(), series.samples.begin() + series.count);
+        std::sort(sorted.begin(), sorted.end());
+        
+        double total = 0.0;
+        for (float sample : sorted)
+            total += sample;
+        
+        auto percentile = [&](double p) { return (double)sorted[std::min((int)(p * sorted.size()), (int)sorted.size() - 1)]; };
+        
+        ProfileStats stats;
+        stats.name = series.name;
+        stats.gpu = series.gpu;
+        stats.samples = series.count;
+        stats.average = total / series.count;
+        stats.p50 = percentile(0.50);
+        stats.p95 = percentile(0.95);
+        stats.p99 = percentile(0.99);
+        stats.max = sorted.back();
+        result.push_back(stats);
+    }
+    return result;
+}
+
+void Profiler::logStats()
+{
+    LOG_INFO("[PROFILE] zone                         avg ms   p50 ms   p95 ms   p99 ms   max ms");
+    for (const ProfileStats& stats : getStats())
+    {
+        LOG_INFOF("[PROFILE] %-4s %-24s %8.3f %8.3f %8.3f %8.3f %8.3f",
+                  stats.gpu ? "GPU" : "CPU", stats.name.c_str(),
+                  stats.average, stats.p50, stats.p95, stats.p99, stats.max);
+    }
+}
+
+void Profiler::finishCapture()
+{
+    FILE* file = std::fopen(s_capturePath.c_str(), "w");
+    if (!file)
+    {
+        LOG_ERROR("[PROFILE] Failed to write trace: " + s_capturePath);
+        s_events.clear();
+        return;
+    }
+    
+    
+    std::fprintf(file, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+    std::fprintf(file, "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":1,\"args\":{\"name\":\"Main\"}},\n");
+    std::fprintf(file, "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":2,\"args\":{\"name\":\"GPU\"}}");
+    for (const TraceEvent& event : s_events)
+    {
+        std::fprintf(file, ",\n{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f}",
+                     event.name, event.gpu ? "gpu" : "cpu", event.gpu ? 2 : 1,
+                     event.start / 1000.0, event.duration / 1000.0);
+    }
+    std::fprintf(file, "\n]}\n");
+    std::fclose(file);
+    
+    LOG_INFO("[PROFILE] Wrote " + std::to_string(s_events.size()) + " events to " + s_capturePath);
+    s_events.clear();
+    logStats();
+}
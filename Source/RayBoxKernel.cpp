@@ -0,0 +1,323 @@
+﻿#include "../Header/RayBoxKernel.h"
+#include <algorithm>
+#include <cstdint>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define RAYBOX_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#else
+#define RAYBOX_X86 0
+#endif
+
+#if RAYBOX_X86 && (defined(__GNUC__) || defined(__clang__))
+#define RAYBOX_TARGET_AVX2 __attribute__((target("avx2")))
+#define RAYBOX_TARGET_SSE2 __attribute__((target("sse2")))
+#else
+#define RAYBOX_TARGET_AVX2
+#define RAYBOX_TARGET_SSE2
+#endif
+
+AABBSoA::AABBSoA()
+    : m_count(0)
+{
+}
+
+void AABBSoA::assign(const std::vector<AABB>& boxes)
+{
+    resize((int)boxes.size());
+    for (int i = 0; i < m_count; ++i)
+        set(i, boxes[i]);
+}
+
+void AABBSoA::resize(int count)
+{
+    
+    int padded = (count + LANES - 1) / LANES * LANES;
+    m_minX.assign(padded, 0.0f);
+    m_minY.assign(padded, 0.0f);
+    m_minZ.assign(padded, 0.0f);
+    m_maxX.assign(padded, 0.0f);
+    m_maxY.assign(padded, 0.0f);
+    m_maxZ.assign(padded, 0.0f);
+    m_count = count;
+}
+
+void AABBSoA::clear()
+{
+    m_minX.clear();
+    m_minY.clear();
+    m_minZ.clear();
+    m_maxX.clear();
+    m_maxY.clear();
+    m_maxZ.clear();
+    m_count = 0;
+}
+
+void AABBSoA::set(int index, const AABB& box)
+{
+    m_minX[index] = box.min.x;
+    m_minY[index] = box.min.y;
+    m_minZ[index] = box.min.z;
+    m_maxX[index] = box.max.x;
+    m_maxY[index] = box.max.y;
+    m_maxZ[index] = box.max.z;
+}
+
+AABB AABBSoA::get(int index) const
+{
+    return AABB(glm::vec3(m_minX[index], m_minY[index], m_minZ[index]),
+                glm::vec3(m_maxX[index], m_maxY[index], m_maxZ[index]));
+}
+
+namespace
+{
+    int intersectScalar(const Ray& ray, const AABBSoA& boxes, int first, int count, float maxDistance, float& tNear)
+    {
+        const glm::vec3& o = ray.origin;
+        const glm::vec3& inv = ray.invDirection;
+        int best = -1;
+        float bestDistance = maxDistance;
+
+        for (int i = first; i < first + count; ++i)
+        {
+            float t1 = (boxes.minX()[i] - o.x) * inv.x;
+            float t2 = (boxes.maxX()[i] - o.x) * inv.x;
+            float t3 = (boxes.minY()[i] - o.y) * inv.y;
+            float t4 = (boxes.maxY()[i] - o.y) * inv.y;
+            float t5 = (boxes.minZ()[i] - o.z) * inv.z;
+            float t6 = (boxes.maxZ()[i] - o.z) * inv.z;
+
+            float tmin = std::max(std::max(std::min(t1, t2), std::min(t3, t4)), std::min(t5, t6));
+            float tmax = std::min(std::min(std::max(t1, t2), std::max(t3, t4)), std::max(t5, t6));
+            if (tmax < 0.0f || tmin > tmax)
+                continue;
+
+            float t = (tmin < 0.0f) ? tmax : tmin;
+            if (t > 0.0f && t < bestDistance)
+            {
+                bestDistance = t;
+                best = i;
+            }
+        }
+
+        if (best >= 0)
+            tNear = bestDistance;
+        return best;
+    }
+
+#if RAYBOX_X86
+    
+    int reduceLanes(const float* distances, const int32_t* indices, int lanes, float& tNear)
+    {
+        int best = -1;
+        float bestDistance = 0.0f;
+        for (int lane = 0; lane < lanes; ++lane)
+        {
+            if (indices[lane] < 0)
+                continue;
+            if (best < 0 || distances[lane] < bestDistance ||
+                (distances[lane] == bestDistance && indices[lane] < best))
+            {
+                best = indices[lane];
+                bestDistance = distances[lane];
+            }
+        }
+
+        if (best >= 0)
+            tNear = bestDistance;
+        return best;
+    }
+
+    RAYBOX_TARGET_SSE2
+    int intersectSSE(const Ray& ray, const AABBSoA& boxes, int first, int count, float maxDistance, float& tNear)
+    {
+        const __m128 ox = _mm_set1_ps(ray.origin.x);
+        const __m128 oy = _mm_set1_ps(ray.origin.y);
+        const __m128 oz = _mm_set1_ps(ray.origin.z);
+        const __m128 ix = _mm_set1_ps(ray.invDirection.x);
+        const __m128 iy = _mm_set1_ps(ray.invDirection.y);
+        const __m128 iz = _mm_set1_ps(ray.invDirection.z);
+        const __m128 zero = _mm_setzero_ps();
+        const __m128i firstIndex = _mm_set1_epi32(first - 1);
+        const __m128i endIndex = _mm_set1_epi32(first + count);
+
+        __m128 bestDistance = _mm_set1_ps(maxDistance);
+        __m128i bestIndex = _mm_set1_epi32(-1);
+
+        
+        int end = first + count;
+        for (int base = first & ~3; base < end; base += 4)
+        {
+            __m128 t1 = _mm_mul_ps(_mm_sub_ps(_mm_load_ps(boxes.minX() + base), ox), ix);
+            __m128 t2 = _mm_mul_ps(_mm_sub_ps(_mm_load_ps(boxes.maxX() + base), ox), ix);
+            __m128 t3 = _mm_mul_ps(_mm_sub_ps(_mm_load_ps(boxes.minY() + base), oy), iy);
+            __m128 t4 = _mm_mul_ps(_mm_sub_ps(_mm_load_ps(boxes.maxY() + base), oy), iy);
+            __m128 t5 = _mm_mul_ps(_mm_sub_ps(_mm_load_ps(boxes.minZ() + base), oz), iz);
+            __m128 t6 = _mm_mul_ps(_mm_sub_ps(_mm_load_ps(boxes.maxZ() + base), oz), iz);
+
+            __m128 tmin = _mm_max_ps(_mm_max_ps(_mm_min_ps(t1, t2), _mm_min_ps(t3, t4)), _mm_min_ps(t5, t6));
+            __m128 tmax = _mm_min_ps(_mm_min_ps(_mm_max_ps(t1, t2), _mm_max_ps(t3, t4)), _mm_max_ps(t5, t6));
+
+            __m128 inside = _mm_cmplt_ps(tmin, zero);
+            __m128 t = _mm_or_ps(_mm_and_ps(inside, tmax), _mm_andnot_ps(inside, tmin));
+
+            __m128i index = _mm_add_epi32(_mm_set1_epi32(base), _mm_setr_epi32(0, 1, 2, 3));
+            __m128i inRange = _mm_and_si128(_mm_cmpgt_epi32(index, firstIndex), _mm_cmplt_epi32(index, endIndex));
+
+            __m128 hit = _mm_and_ps(_mm_cmpge_ps(tmax, zero), _mm_cmple_ps(tmin, tmax));
+            hit = _mm_and_ps(hit, _mm_and_ps(_mm_cmpgt_ps(t, zero), _mm_cmplt_ps(t, bestDistance)));
+            hit = _mm_and_ps(hit, _mm_castsi128_ps(inRange));
+
+            bestDistance = _mm_or_ps(_mm_and_ps(hit, t), _mm_andnot_ps(hit, bestDistance));
+            __m128i hitMask = _mm_castps_si128(hit);
+            bestIndex = _mm_or_si128(_mm_and_si128(hitMask, index), _mm_andnot_si128(hitMask, bestIndex));
+        }
+
+        alignas(16) float distances[4];
+        alignas(16) int32_t indices[4];
+        _mm_store_ps(distances, bestDistance);
+        _mm_store_si128(reinterpret_cast<__m128i*>(indices), bestIndex);
+        return reduceLanes(distances, indices, 4, tNear);
+    }
+
+    RAYBOX_TARGET_AVX2
+    int intersectAVX2(const Ray& ray, const AABBSoA& boxes, int first, int count, float maxDistance, float& tNear)
+    {
+        const __m256 ox = _mm256_set1_ps(ray.origin.x);
+        const __m256 oy = _mm256_set1_ps(ray.origin.y);
+        const __m256 oz = _mm256_set1_ps(ray.origin.z);
+        const __m256 ix = _mm256_set1_ps(ray.invDirection.x);
+        const __m256 iy = _mm256_set1_ps(ray.invDirection.y);
+        const __m256 iz = _mm256_set1_ps(ray.invDirection.z);
+        const __m256 zero = _mm256_setzero_ps();
+        const __m256i firstIndex = _mm256_set1_epi32(first - 1);
+        const __m256i endIndex = _mm256_set1_epi32(first + count);
+        const __m256i laneOffsets = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+
+        __m256 bestDistance = _mm256_set1_ps(maxDistance);
+        __m256i bestIndex = _mm256_set1_epi32(-1);
+
+        int end = first + count;
+        for (int base = first & ~7; base < end; base += 8)
+        {
+            __m256 t1 = _mm256_mul_ps(_mm256_sub_ps(_mm256_load_ps(boxes.minX() + base), ox), ix);
+            __m256 t2 = _mm256_mul_ps(_mm256_sub_ps(_mm256_load_ps(boxes.maxX() + base), ox), ix);
+            __m256 t3 = _mm256_mul_ps(_mm256_sub_ps(_mm256_load_ps(boxes.minY() + base), oy), iy);
+            __m256 t4 = _mm256_mul_ps(_mm256_sub_ps(_mm256_load_ps(boxes.maxY() + base), oy), iy);
+            __m256 t5 = _mm256_mul_ps(_mm256_sub_ps(_mm256_load_ps(boxes.minZ() + base), oz), iz);
+            __m256 t6 = _mm256_mul_ps(_mm256_sub_ps(_mm256_load_ps(boxes.maxZ() + base), oz), iz);
+
+            __m256 tmin = _mm256_max_ps(_mm256_max_ps(_mm256_min_ps(t1, t2), _mm256_min_ps(t3, t4)), _mm256_min_ps(t5, t6));
+            __m256 tmax = _mm256_min_ps(_mm256_min_ps(_mm256_max_ps(t1, t2), _mm256_max_ps(t3, t4)), _mm256_max_ps(t5, t6));
+
+            __m256 t = _mm256_blendv_ps(tmin, tmax, _mm256_cmp_ps(tmin, zero, _CMP_LT_OQ));
+
+            __m256i index = _mm256_add_epi32(_mm256_set1_epi32(base), laneOffsets);
+            __m256i inRange = _mm256_and_si256(_mm256_cmpgt_epi32(index, firstIndex), _mm256_cmpgt_epi32(endIndex, index));
+
+            __m256 hit = _mm256_and_ps(_mm256_cmp_ps(tmax, zero, _CMP_GE_OQ), _mm256_cmp_ps(tmin, tmax, _CMP_LE_OQ));
+            hit = _mm256_and_ps(hit, _mm256_and_ps(_mm256_cmp_ps(t, zero, _CMP_GT_OQ), _mm256_cmp_ps(t, bestDistance, _CMP_LT_OQ)));
+            hit = _mm256_and_ps(hit, _mm256_castsi256_ps(inRange));
+
+            bestDistance = _mm256_blendv_ps(bestDistance, t, hit);
+            bestIndex = _mm256_castps_si256(_mm256_blendv_ps(_mm256_castsi256_ps(bestIndex), _mm256_castsi256_ps(index), hit));
+        }
+
+        alignas(32) float distances[8];
+        alignas(32) int32_t indices[8];
+        _mm256_store_ps(distances, bestDistance);
+        _mm256_store_si256(reinterpret_cast<__m256i*>(indices), bestIndex);
+        return reduceLanes(distances, indices, 8, tNear);
+    }
+
+    SimdLevel detectLevel()
+    {
+#if defined(_MSC_VER)
+        int info[4];
+        __cpuid(info, 0);
+        int maxLeaf = info[0];
+
+        __cpuid(info, 1);
+        bool sse2 = (info[3] & (1 << 26)) != 0;
+        bool osxsave = (info[2] & (1 << 27)) != 0;
+        bool avx = (info[2] & (1 << 28)) != 0;
+
+        bool avx2 = false;
+        if (maxLeaf >= 7 && osxsave && avx && (_xgetbv(0) & 0x6) == 0x6)
+        {
+            __cpuidex(info, 7, 0);
+            avx2 = (info[1] & (1 << 5)) != 0;
+        }
+#else
+        __builtin_cpu_init();
+        bool sse2 = __builtin_cpu_supports("sse2") != 0;
+        bool avx2 = __builtin_cpu_supports("avx2") != 0;
+#endif
+        if (avx2)
+            return SimdLevel::AVX2;
+        if (sse2)
+            return SimdLevel::SSE;
+        return SimdLevel::Scalar;
+    }
+#else
+    SimdLevel detectLevel()
+    {
+        return SimdLevel::Scalar;
+    }
+#endif
+}
+
+SimdLevel RayBoxKernel::s_level = RayBoxKernel::getSupportedLevel();
+
+SimdLevel RayBoxKernel::getSupportedLevel()
+{
+    static const SimdLevel supported = detectLevel();
+    return supported;
+}
+
+SimdLevel RayBoxKernel::getLevel()
+{
+    return s_level;
+}
+
+void RayBoxKernel::setLevel(SimdLevel level)
+{
+    s_level = std::min(level, getSupportedLevel());
+}
+
+const char* RayBoxKernel::levelName(SimdLevel level)
+{
+    switch (level)
+    {
+    case SimdLevel::AVX2: return "avx2";
+    case SimdLevel::SSE: return "sse";
+    default: return "scalar";
+    }
+}
+
+int RayBoxKernel::intersectNearest(const Ray& ray, const AABBSoA& boxes, int first, int count,
+                                   float maxDistance, float& tNear)
+{
+    return intersectNearest(s_level, ray, boxes, first, count, maxDistance, tNear);
+}
+
+int RayBoxKernel::intersectNearest(SimdLevel level, const Ray& ray, const AABBSoA& boxes, int first, int count,
+                                   float maxDistance, float& tNear)
+{
+    if (count <= 0)
+        return -1;
+
+#if RAYBOX_X86
+    level = std::min(level, getSupportedLevel());
+    if (level == SimdLevel::AVX2)
+        return intersectAVX2(ray, boxes, first, count, maxDistance, tNear);
+    if (level == SimdLevel::SSE)
+        return intersectSSE(ray, boxes, first, count, maxDistance, tNear);
+#else
+    (void)level;
+#endif
+    return intersectScalar(ray, boxes, first, count, maxDistance, tNear);
+}
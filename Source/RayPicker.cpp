@@ -1,12 +1,13 @@
 ﻿#include "../Header/RayPicker.h"
 #include "../Header/AABB.h"
-#include "../Header/Seat.h"
 #include "../Header/SeatGrid.h"
 #include <glm/gtc/matrix_transform.hpp>
 #include <algorithm>
 #include <limits>
 
 RayPicker::RayPicker()
+    : m_seatCount(0)
+    , m_hasDoor(false)
 {
 }
 
@@ -53,11 +54,7 @@ bool RayPicker::intersectAABB(const Ray& ray, const AABB& box, float& tNear) con
     
     
     
-    glm::vec3 invDir(
-        1.0f / ray.direction.x,
-        1.0f / ray.direction.y,
-        1.0f / ray.direction.z
-    );
+    const glm::vec3& invDir = ray.invDirection;
     
     
     float t1 = (box.min.x - ray.origin.x) * invDir.x;
@@ -91,32 +88,89 @@ bool RayPicker::intersectAABB(const Ray& ray, const AABB& box, float& tNear) con
     return true;
 }
 
-Seat* RayPicker::pickSeat(const Ray& ray, SeatGrid& grid) const
+int RayPicker::pickSeat(const Ray& ray, const SeatGrid& grid) const
 {
     float closestDistance = std::numeric_limits<float>::max();
-    Seat* closestSeat = nullptr;
+    int closestSeat = -1;
     
-    
-    for (int row = 0; row < SeatGrid::ROWS; ++row)
+    const std::vector<AABB>& bounds = grid.getSeatBounds();
+    for (int i = 0; i < (int)bounds.size(); ++i)
     {
-        for (int col = 0; col < SeatGrid::COLS; ++col)
+        float tNear;
+        if (intersectAABB(ray, bounds[i], tNear))
         {
-            Seat* seat = grid.getSeat(row, col);
-            if (!seat)
-                continue;
             
-            float tNear;
-            if (intersectAABB(ray, seat->bounds, tNear))
+            if (tNear > 0.0f && tNear < closestDistance)
             {
-                
-                if (tNear > 0.0f && tNear < closestDistance)
-                {
-                    closestDistance = tNear;
-                    closestSeat = seat;
-                }
+                closestDistance = tNear;
+                closestSeat = i;
             }
         }
     }
     
     return closestSeat;
 }
+
+void RayPicker::buildScene(const SeatGrid& grid, const std::vector<AABB>& hallBounds)
+{
+    
+    const std::vector<AABB>& seatBounds = grid.getSeatBounds();
+    std::vector<AABB> primitives;
+    primitives.reserve(seatBounds.size() + hallBounds.size());
+    primitives.insert(primitives.end(), seatBounds.begin(), seatBounds.end());
+    primitives.insert(primitives.end(), hallBounds.begin(), hallBounds.end());
+    
+    m_seatCount = (int)seatBounds.size();
+    m_staticBVH.build(primitives);
+}
+
+void RayPicker::updatePeople(const std::vector<AABB>& peopleBounds)
+{
+    
+    
+    m_peopleBVH.refit(peopleBounds);
+    if (m_peopleBVH.getRefitGrowth() > REBUILD_GROWTH)
+    {
+        m_peopleBVH.build(peopleBounds);
+    }
+}
+
+PickResult RayPicker::pick(const Ray& ray) const
+{
+    PickResult result;
+    
+    BVHHit hit;
+    if (m_staticBVH.intersect(ray, hit))
+    {
+        result.target = hit.primitive < m_seatCount ? PickTarget::Seat : PickTarget::Hall;
+        result.index = hit.primitive < m_seatCount ? hit.primitive : hit.primitive - m_seatCount;
+        result.distance = hit.distance;
+    }
+    
+    
+    BVHHit personHit;
+    personHit.distance = hit.distance;
+    if (m_peopleBVH.intersect(ray, personHit))
+    {
+        result.target = PickTarget::Person;
+        result.index = personHit.primitive;
+        result.distance = personHit.distance;
+    }
+    
+    float doorDistance;
+    if (m_hasDoor && intersectAABB(ray, m_doorBounds, doorDistance) && doorDistance > 0.0f &&
+        (result.target == PickTarget::None || doorDistance < result.distance))
+    {
+        result.target = PickTarget::Door;
+        result.index = 0;
+        result.distance = doorDistance;
+    }
+    
+    return result;
+}
+
+int RayPicker::pickSeatOccluded(const Ray& ray) const
+{
+    PickResult result = pick(ray);
+    return result.target == PickTarget::Seat ? result.index : -1;
+}
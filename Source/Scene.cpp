@@ -1,11 +1,20 @@
 ﻿#include "../Header/Scene.h"
-#include "../Header/DebugCube.h"
 #include "../Header/Camera.h"
 #include "../Header/Light.h"
+#include "../Header/SeatLayout.h"
+#ifndef KOSTUR_HEADLESS_ONLY
+#include "../Header/DebugCube.h"
 #include "../Shader.h"
+#include <GL/glew.h>
+#endif
 
 Scene::Scene()
     : m_cubeMesh(nullptr)
+    , m_staticShader(nullptr)
+    , m_staticVAO(0)
+    , m_staticVBO(0)
+    , m_staticVertexCount(0)
+    , m_staticBatchDirty(true)
     , m_floorIndex(-1)
     , m_ceilingIndex(-1)
     , m_frontWallIndex(-1)
@@ -16,20 +25,44 @@ Scene::Scene()
     , m_doorIndex(-1)
     , m_firstPlatformIndex(-1)
     , m_firstStairIndex(-1)
+    , m_stairCount(0)
+    , m_doorPosition(0.0f)
+    , m_screenPosition(0.0f)
 {
 }
 
 Scene::~Scene()
 {
+#ifndef KOSTUR_HEADLESS_ONLY
+    releaseStaticBatch();
+#endif
 }
 
-void Scene::init(DebugCube* cubeMesh)
+void Scene::init(DebugCube* cubeMesh, const SeatLayout& layout)
 {
     m_cubeMesh = cubeMesh;
-    createHallGeometry();
+    computeHallExtents(layout);
+    createHallGeometry(layout);
     createLights();
 }
 
+void Scene::computeHallExtents(const SeatLayout& layout)
+{
+    
+    const float platformHalfWidth = (layout.cols * layout.seatSpacingX + layout.totalAisleWidth() + 1.0f) * 0.5f;
+    const float platformHalfDepth = 1.5f;
+    const float lastRowZ = layout.origin.z + (layout.rows - 1) * layout.seatSpacingZ;
+    
+    float leftX = layout.origin.x - platformHalfWidth - SIDE_CLEARANCE;
+    float rightX = layout.origin.x + platformHalfWidth + SIDE_CLEARANCE;
+    float frontZ = layout.origin.z - FRONT_CLEARANCE;
+    float backZ = lastRowZ + platformHalfDepth + BACK_CLEARANCE;
+    
+    m_hallBounds = AABB(glm::vec3(leftX, FLOOR_Y, frontZ), glm::vec3(rightX, CEILING_Y, backZ));
+    m_doorPosition = glm::vec3(leftX + 0.1f, 1.75f, frontZ + DOOR_FROM_FRONT);
+    m_screenPosition = glm::vec3(layout.origin.x, 3.0f, frontZ + 0.2f);
+}
+
 void Scene::update(float deltaTime)
 {
     
@@ -39,8 +72,9 @@ void Scene::update(float deltaTime)
 void Scene::createLights()
 {
     
+    glm::vec3 hallCenter = (m_hallBounds.min + m_hallBounds.max) * 0.5f;
     m_roomLight = Light(
-        glm::vec3(0.0f, 4.0f, 0.0f),      
+        glm::vec3(hallCenter.x, 4.0f, hallCenter.z),      
         glm::vec3(1.0f, 0.95f, 0.85f),    
         5.0f,                              
         true                               
@@ -48,70 +82,157 @@ void Scene::createLights()
     
     
     m_screenLight = Light(
-        glm::vec3(0.0f, 3.0f, -8.5f),     
+        m_screenPosition + glm::vec3(0.0f, 0.0f, 0.3f),     
         glm::vec3(1.0f, 1.0f, 1.0f),      
         8.0f,                              
         false                              
     );
 }
 
-void Scene::draw(const glm::mat4& view, const glm::mat4& projection, 
-                 Shader* phongShader, Shader* basicShader, const glm::vec3& viewPos)
+const Light& Scene::getActiveLight() const
 {
-    if (!m_cubeMesh || !phongShader || !basicShader)
-        return;
     
     
-    
-    Light* activeLight = &m_roomLight;
     if (m_screenLight.enabled && !m_roomLight.enabled)
-        activeLight = &m_screenLight;
+        return m_screenLight;
     
+    return m_roomLight;
+}
+
+void Scene::addStaticObject(const SceneObject& object)
+{
+    m_objects.push_back(object);
+    m_staticBatchDirty = true;
+}
+
+#ifndef KOSTUR_HEADLESS_ONLY
+void Scene::draw(Shader* phongShader, Shader* basicShader)
+{
+    if (!m_cubeMesh || !phongShader || !basicShader)
+        return;
+    
+    if (m_staticShader)
+    {
+        if (m_staticBatchDirty)
+            rebuildStaticBatch();
+        
+        m_staticShader->use();
+        glBindVertexArray(m_staticVAO);
+        glDrawArrays(GL_TRIANGLES, 0, m_staticVertexCount);
+        glBindVertexArray(0);
+        return;
+    }
+    
+    phongShader->use();
+    GLint modelLoc = phongShader->uniformLocation("model");
+    GLint colorLoc = phongShader->uniformLocation("uBaseColor");
     
     
     for (size_t i = 0; i < m_objects.size(); ++i)
     {
         const auto& obj = m_objects[i];
         
+        phongShader->setMat4(modelLoc, obj.modelMatrix());
+        phongShader->setVec3(colorLoc, obj.color);
         
-        phongShader->use();
-        phongShader->setMat4("model", obj.modelMatrix());
-        phongShader->setMat4("view", view);
-        phongShader->setMat4("projection", projection);
-        
-        
-        phongShader->setVec3("uBaseColor", obj.color);
-        
-        
-        phongShader->setVec3("lightPos", activeLight->position);
-        phongShader->setVec3("lightColor", activeLight->color);
-        phongShader->setFloat("lightIntensity", activeLight->intensity);
+        m_cubeMesh->draw();
+    }
+}
+
+void Scene::rebuildStaticBatch()
+{
+    const int cubeVertexCount = DebugCube::VERTEX_COUNT;
+    const int cubeStride = DebugCube::FLOATS_PER_VERTEX;
+    const float* cube = DebugCube::getVertexData();
+    
+    
+    const int stride = 9;
+    std::vector<float> vertices;
+    vertices.reserve(m_objects.size() * cubeVertexCount * stride);
+    
+    for (const SceneObject& obj : m_objects)
+    {
+        for (int v = 0; v < cubeVertexCount; ++v)
+        {
+            const float* src = cube + v * cubeStride;
+            
+            
+            vertices.push_back(obj.position.x + src[0] * obj.scale.x);
+            vertices.push_back(obj.position.y + src[1] * obj.scale.y);
+            vertices.push_back(obj.position.z + src[2] * obj.scale.z);
+            
+            vertices.push_back(src[3]);
+            vertices.push_back(src[4]);
+            vertices.push_back(src[5]);
+            
+            vertices.push_back(obj.color.r);
+            vertices.push_back(obj.color.g);
+            vertices.push_back(obj.color.b);
+        }
+    }
+    
+    if (m_staticVAO == 0)
+    {
+        glGenVertexArrays(1, &m_staticVAO);
+        glGenBuffers(1, &m_staticVBO);
         
+        glBindVertexArray(m_staticVAO);
+        glBindBuffer(GL_ARRAY_BUFFER, m_staticVBO);
         
-        int lightEnabledInt = activeLight->enabled ? 1 : 0;
-        glUniform1i(glGetUniformLocation(phongShader->ID, "lightEnabled"), lightEnabledInt);
+        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, stride * sizeof(float), (void*)0);
+        glEnableVertexAttribArray(0);
         
+        glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, stride * sizeof(float), (void*)(3 * sizeof(float)));
+        glEnableVertexAttribArray(1);
         
-        phongShader->setVec3("viewPos", viewPos);
+        glVertexAttribPointer(2, 3, GL_FLOAT, GL_FALSE, stride * sizeof(float), (void*)(6 * sizeof(float)));
+        glEnableVertexAttribArray(2);
         
-        m_cubeMesh->draw();
+        glBindVertexArray(0);
     }
+    
+    glBindBuffer(GL_ARRAY_BUFFER, m_staticVBO);
+    glBufferData(GL_ARRAY_BUFFER, (GLsizeiptr)(vertices.size() * sizeof(float)),
+                 vertices.data(), GL_STATIC_DRAW);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    
+    m_staticVertexCount = (int)(vertices.size() / stride);
+    m_staticBatchDirty = false;
 }
 
-void Scene::createHallGeometry()
+void Scene::releaseStaticBatch()
+{
+    if (m_staticVAO != 0)
+    {
+        glDeleteVertexArrays(1, &m_staticVAO);
+        glDeleteBuffers(1, &m_staticVBO);
+        m_staticVAO = 0;
+        m_staticVBO = 0;
+        m_staticVertexCount = 0;
+    }
+}
+#endif
+
+void Scene::createHallGeometry(const SeatLayout& layout)
 {
     
     
     
     
     
-    const float hallWidth = 18.0f;
-    const float hallDepth = 18.0f;
+    const float leftX = m_hallBounds.min.x;
+    const float rightX = m_hallBounds.max.x;
+    const float frontZ = m_hallBounds.min.z;
+    const float backZ = m_hallBounds.max.z;
+    const float hallWidth = rightX - leftX;
+    const float hallDepth = backZ - frontZ;
+    const float centerX = (leftX + rightX) * 0.5f;
+    const float centerZ = (frontZ + backZ) * 0.5f;
     const float hallHeight = 4.5f;
     const float wallThickness = 0.2f;
     
-    const float floorY = 0.5f;
-    const float ceilingY = 5.0f;
+    const float floorY = FLOOR_Y;
+    const float ceilingY = CEILING_Y;
     
     
     const glm::vec3 floorColor(0.25f, 0.25f, 0.3f);      
@@ -124,12 +245,13 @@ void Scene::createHallGeometry()
     
     
     m_objects.clear();
+    m_staticBatchDirty = true;
     
     
     
     m_floorIndex = (int)m_objects.size();
     m_objects.push_back(SceneObject(
-        glm::vec3(0.0f, floorY - 0.05f, 0.0f),  
+        glm::vec3(centerX, floorY - 0.05f, centerZ),  
         glm::vec3(hallWidth, 0.1f, hallDepth),   
         floorColor
     ));
@@ -138,44 +260,40 @@ void Scene::createHallGeometry()
     
     m_ceilingIndex = (int)m_objects.size();
     m_objects.push_back(SceneObject(
-        glm::vec3(0.0f, ceilingY + 0.05f, 0.0f), 
+        glm::vec3(centerX, ceilingY + 0.05f, centerZ), 
         glm::vec3(hallWidth, 0.1f, hallDepth),    
         ceilingColor
     ));
     
     
     
-    const float frontZ = -9.0f;
     m_frontWallIndex = (int)m_objects.size();
     m_objects.push_back(SceneObject(
-        glm::vec3(0.0f, (floorY + ceilingY) / 2.0f, frontZ), 
+        glm::vec3(centerX, (floorY + ceilingY) / 2.0f, frontZ), 
         glm::vec3(hallWidth, hallHeight, wallThickness),     
         wallColor
     ));
     
     
-    const float backZ = 9.0f;
     m_backWallIndex = (int)m_objects.size();
     m_objects.push_back(SceneObject(
-        glm::vec3(0.0f, (floorY + ceilingY) / 2.0f, backZ), 
+        glm::vec3(centerX, (floorY + ceilingY) / 2.0f, backZ), 
         glm::vec3(hallWidth, hallHeight, wallThickness),    
         wallColor
     ));
     
     
-    const float leftX = -9.0f;
     m_leftWallIndex = (int)m_objects.size();
     m_objects.push_back(SceneObject(
-        glm::vec3(leftX, (floorY + ceilingY) / 2.0f, 0.0f), 
+        glm::vec3(leftX, (floorY + ceilingY) / 2.0f, centerZ), 
         glm::vec3(wallThickness, hallHeight, hallDepth),    
         wallColor
     ));
     
     
-    const float rightX = 9.0f;
     m_rightWallIndex = (int)m_objects.size();
     m_objects.push_back(SceneObject(
-        glm::vec3(rightX, (floorY + ceilingY) / 2.0f, 0.0f), 
+        glm::vec3(rightX, (floorY + ceilingY) / 2.0f, centerZ), 
         glm::vec3(wallThickness, hallHeight, hallDepth),     
         wallColor
     ));
@@ -198,16 +316,17 @@ void Scene::createHallGeometry()
     m_firstStairIndex = (int)m_objects.size();  
     
     const float stepWidth = 2.9f;        
-    const float stepHeight = 0.3f;       
-    const float stepDepth = 1.2f;        
-    const float stairsStartZ = 1.2f;    
+    const float stepHeight = layout.rowElevationStep;
+    const float stepDepth = layout.seatSpacingZ;
+    const float stairsStartZ = layout.origin.z - 0.8f;
     
     
     
     
-    const float leftStairsX = -8.0f;  
+    const float leftStairsX = leftX + 1.0f;
+    m_stairCount = layout.rows;
     
-    for (int i = 0; i < 5; ++i)
+    for (int i = 0; i < m_stairCount; ++i)
     {
         
         float stepTopY = floorY + (i + 1) * stepHeight;
@@ -229,6 +348,28 @@ void Scene::createHallGeometry()
     }
 }
 
+AABB Scene::getFloorBounds() const
+{
+    if (m_floorIndex < 0)
+        return AABB();
+    
+    const SceneObject& floor = m_objects[m_floorIndex];
+    glm::vec3 halfExtents = floor.scale * 0.5f;
+    return AABB(floor.position - halfExtents, floor.position + halfExtents);
+}
+
+std::vector<AABB> Scene::getOccluderBounds() const
+{
+    std::vector<AABB> bounds;
+    bounds.reserve(m_objects.size());
+    for (const SceneObject& obj : m_objects)
+    {
+        glm::vec3 halfExtents = obj.scale * 0.5f;
+        bounds.push_back(AABB(obj.position - halfExtents, obj.position + halfExtents));
+    }
+    return bounds;
+}
+
 std::vector<AABB> Scene::getCollidableBounds() const
 {
     std::vector<AABB> bounds;
@@ -237,7 +378,7 @@ std::vector<AABB> Scene::getCollidableBounds() const
     
     if (m_firstStairIndex >= 0)
     {
-        for (int i = 0; i < 5; ++i)  
+        for (int i = 0; i < m_stairCount; ++i)
         {
             int idx = m_firstStairIndex + i;
             if (idx < (int)m_objects.size())
@@ -1,28 +1,47 @@
 ﻿#include "../Header/Screen.h"
 #include "../Header/Log.h"
+#ifndef KOSTUR_HEADLESS_ONLY
 #include "../Shader.h"
 #include <GL/glew.h>
+#endif
 #include <glm/gtc/matrix_transform.hpp>
 
-#include "../Header/stb_image.h"
-
+#include <chrono>
+#include <cstdio>
+#include <cstring>
 #include <string>
 #include <sstream>
 #include <iomanip>
 
+#ifndef KOSTUR_HEADLESS_ONLY
+static double screenClockMs()
+{
+    return std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+#endif
+
 Screen::Screen()
-    : m_whiteTexture(0)
+    : m_streaming(false)
+    , m_headless(false)
+    , m_headlessFrameCount(0)
+    , m_uploadedFrames(0)
+    , m_resolvedFrames(0)
+    , m_loadStartTime(0.0)
     , m_playing(false)
     , m_timer(0.0f)
     , m_currentFrame(0)
     , m_debugUV(false)
     , m_forceSolidColor(false)
     , m_debugOverlay(false)
+#ifndef KOSTUR_HEADLESS_ONLY
+    , m_whiteTexture(0)
     , m_VAO(0)
     , m_VBO(0)
     , m_overlayVAO(0)
     , m_overlayVBO(0)
     , m_shader(nullptr)
+#endif
     , m_position(0.0f, 3.0f, -8.8f)  
     , m_size(10.0f, 5.0f)
 {
@@ -30,11 +49,18 @@ Screen::Screen()
 
 Screen::~Screen()
 {
+#ifndef KOSTUR_HEADLESS_ONLY
+    m_decodePool.shutdown();
+    m_filmStream.cleanup();
+    
     if (m_whiteTexture)
         glDeleteTextures(1, &m_whiteTexture);
     
-    if (!m_filmTextures.empty())
-        glDeleteTextures(static_cast<GLsizei>(m_filmTextures.size()), m_filmTextures.data());
+    for (unsigned int texture : m_filmTextures)
+    {
+        if (texture)
+            glDeleteTextures(1, &texture);
+    }
     
     if (m_VAO)
         glDeleteVertexArrays(1, &m_VAO);
@@ -46,11 +72,12 @@ Screen::~Screen()
         glDeleteBuffers(1, &m_overlayVBO);
     
     delete m_shader;
+#endif
 }
 
+#ifndef KOSTUR_HEADLESS_ONLY
 void Screen::init()
 {
-    loadFilmTextures();
     createWhiteTexture();
     setupScreenQuad();
     
@@ -62,32 +89,177 @@ void Screen::init()
         return;
     }
     
-    LOG_INFO("[SCREEN] Initialized with " + std::to_string(m_filmTextures.size()) + " film frames");
+    queueFilmFrames();
+    
+    LOG_INFO("[SCREEN] Initialized with " + std::to_string(getFrameCount()) + " film frames (" +
+             std::string(m_streaming ? "streaming" : "resident") + ")");
 }
+#endif
 
-void Screen::loadFilmTextures()
+void Screen::initHeadless()
 {
-    m_filmTextures.clear();
     
-    for (int i = 1; i <= 100; ++i)
+    m_headless = true;
+    m_headlessFrameCount = (int)findFilmFramePaths().size();
+    
+    LOG_INFO("[SCREEN] Headless timing with " + std::to_string(m_headlessFrameCount) + " film frames");
+}
+
+std::vector<std::string> Screen::findFilmFramePaths() const
+{
+    std::vector<std::string> paths;
+    for (int i = 1; i <= MAX_FILM_FRAMES; ++i)
     {
         std::ostringstream oss;
         oss << "Assets/Textures/" << std::setfill('0') << std::setw(3) << i << ".png";
         std::string filename = oss.str();
         
-        unsigned int texture = loadTexture(filename.c_str());
-        if (texture != 0)
+        FILE* probe = std::fopen(filename.c_str(), "rb");
+        if (probe)
         {
-            m_filmTextures.push_back(texture);
+            std::fclose(probe);
+            paths.push_back(filename);
         }
     }
+    return paths;
+}
+
+#ifndef KOSTUR_HEADLESS_ONLY
+void Screen::queueFilmFrames()
+{
+    m_filmTextures.clear();
+    m_frameResolved.clear();
+    m_uploadedFrames = 0;
+    m_resolvedFrames = 0;
+    m_streaming = false;
     
-    if (m_filmTextures.empty())
+    std::vector<std::string> paths = findFilmFramePaths();
+    if (paths.empty())
     {
         LOG_INFO("[SCREEN] No film textures found - using white screen");
+        return;
+    }
+    
+    
+    if ((int)paths.size() > RESIDENT_FRAME_LIMIT && m_filmStream.init(paths, STREAM_RING_SIZE))
+    {
+        m_streaming = true;
+        return;
+    }
+    
+    m_filmTextures.assign(paths.size(), 0);
+    m_frameResolved.assign(paths.size(), false);
+    m_loadStartTime = screenClockMs();
+    
+    m_decodePool.init();
+    for (size_t i = 0; i < paths.size(); ++i)
+    {
+        m_decodePool.request((int)i, paths[i], true, 4);
+    }
+}
+#endif
+
+int Screen::getFrameCount() const
+{
+    if (m_headless)
+        return m_headlessFrameCount;
+#ifndef KOSTUR_HEADLESS_ONLY
+    return m_streaming ? m_filmStream.getFrameCount() : (int)m_filmTextures.size();
+#else
+    return 0;
+#endif
+}
+
+#ifndef KOSTUR_HEADLESS_ONLY
+void Screen::uploadDecodedFrames(double budgetMs)
+{
+    if (m_streaming)
+    {
+        m_filmStream.update(m_currentFrame, budgetMs);
+        return;
+    }
+    
+    if (m_resolvedFrames == (int)m_filmTextures.size())
+        return;
+    
+    double start = screenClockMs();
+    DecodedImage image;
+    while (screenClockMs() - start < budgetMs && m_decodePool.popCompleted(image))
+    {
+        if (image.id >= 0 && image.id < (int)m_filmTextures.size())
+        {
+            if (image.pixels)
+            {
+                m_filmTextures[image.id] = uploadFrameTexture(image);
+                if (m_filmTextures[image.id] != 0)
+                    ++m_uploadedFrames;
+            }
+            m_frameResolved[image.id] = true;
+            ++m_resolvedFrames;
+        }
+        ImageDecodePool::release(image);
+    }
+    
+    if (m_resolvedFrames == (int)m_filmTextures.size())
+    {
+        std::ostringstream oss;
+        oss << std::fixed << std::setprecision(1) << (screenClockMs() - m_loadStartTime);
+        LOG_INFO("[SCREEN] Uploaded " + std::to_string(m_uploadedFrames) + " film frames in " + oss.str() + " ms");
+        m_decodePool.shutdown();
     }
 }
 
+unsigned int Screen::uploadFrameTexture(const DecodedImage& image)
+{
+    size_t byteSize = (size_t)image.width * image.height * image.channels;
+    GLenum format = (image.channels == 4) ? GL_RGBA : GL_RGB;
+    
+    const void* source = m_uploadBuffer.stage(image.pixels, byteSize);
+    
+    unsigned int textureID;
+    glGenTextures(1, &textureID);
+    glBindTexture(GL_TEXTURE_2D, textureID);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glTexImage2D(GL_TEXTURE_2D, 0, format, image.width, image.height, 0, format, GL_UNSIGNED_BYTE, source);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    m_uploadBuffer.finish();
+    glGenerateMipmap(GL_TEXTURE_2D);
+    
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    
+    glBindTexture(GL_TEXTURE_2D, 0);
+    return textureID;
+}
+#endif
+
+bool Screen::isFrameResolved(int frame) const
+{
+    if (m_headless)
+        return true;
+#ifndef KOSTUR_HEADLESS_ONLY
+    if (m_streaming)
+        return m_filmStream.isFrameResolved(frame);
+    return frame >= 0 && frame < (int)m_frameResolved.size() && m_frameResolved[frame];
+#else
+    return false;
+#endif
+}
+
+#ifndef KOSTUR_HEADLESS_ONLY
+unsigned int Screen::frameTexture(int frame) const
+{
+    
+    for (int i = frame; i >= 0; --i)
+    {
+        if (i < (int)m_filmTextures.size() && m_filmTextures[i] != 0)
+            return m_filmTextures[i];
+    }
+    return m_whiteTexture;
+}
+
 void Screen::createWhiteTexture()
 {
     unsigned char whitePixel[4] = { 255, 255, 255, 255 };
@@ -128,43 +300,11 @@ void Screen::setupScreenQuad()
     
     glBindVertexArray(0);
 }
-
-unsigned int Screen::loadTexture(const char* path)
-{
-    unsigned int textureID;
-    glGenTextures(1, &textureID);
-    
-    int width, height, nrChannels;
-    stbi_set_flip_vertically_on_load(true);  
-    unsigned char* data = stbi_load(path, &width, &height, &nrChannels, 0);
-    
-    if (data)
-    {
-        GLenum format = (nrChannels == 4) ? GL_RGBA : GL_RGB;
-        
-        glBindTexture(GL_TEXTURE_2D, textureID);
-        glTexImage2D(GL_TEXTURE_2D, 0, format, width, height, 0, format, GL_UNSIGNED_BYTE, data);
-        glGenerateMipmap(GL_TEXTURE_2D);
-        
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-        
-        stbi_image_free(data);
-        glBindTexture(GL_TEXTURE_2D, 0);
-        return textureID;
-    }
-    else
-    {
-        glDeleteTextures(1, &textureID);
-        return 0;
-    }
-}
+#endif
 
 void Screen::startPlayback()
 {
-    if (m_filmTextures.empty())
+    if (getFrameCount() == 0)
         return;
     
     m_playing = true;
@@ -180,25 +320,41 @@ void Screen::stopAndResetToWhite()
     m_currentFrame = 0;
 }
 
+#ifndef KOSTUR_HEADLESS_ONLY
+void Screen::uploadPendingFrames()
+{
+    if (!m_headless)
+        uploadDecodedFrames(UPLOAD_BUDGET_MS);
+}
+#endif
+
 void Screen::update(float deltaTime)
 {
-    if (!m_playing || m_filmTextures.empty())
+    if (!m_playing || getFrameCount() == 0)
         return;
     
-    m_timer += deltaTime;
+    float nextTimer = m_timer + deltaTime;
     
-    if (m_timer >= FILM_DURATION)
+    if (nextTimer >= FILM_DURATION)
     {
         stopAndResetToWhite();
         return;
     }
     
-    float frameDuration = FILM_DURATION / m_filmTextures.size();
-    m_currentFrame = std::min(static_cast<int>(m_timer / frameDuration), 
-                              static_cast<int>(m_filmTextures.size()) - 1);
+    float frameDuration = FILM_DURATION / getFrameCount();
+    int nextFrame = std::min(static_cast<int>(nextTimer / frameDuration), 
+                             getFrameCount() - 1);
+    
+    
+    if (!isFrameResolved(nextFrame))
+        return;
+    
+    m_timer = nextTimer;
+    m_currentFrame = nextFrame;
 }
 
-void Screen::draw(const glm::mat4& view, const glm::mat4& projection)
+#ifndef KOSTUR_HEADLESS_ONLY
+void Screen::draw()
 {
     if (!m_shader || m_VAO == 0)
         return;
@@ -212,20 +368,30 @@ void Screen::draw(const glm::mat4& view, const glm::mat4& projection)
     model = glm::scale(model, glm::vec3(m_size.x, m_size.y, 1.0f));
     
     m_shader->setMat4("model", model);
-    m_shader->setMat4("view", view);
-    m_shader->setMat4("projection", projection);
     
     
     unsigned int tex = m_whiteTexture;
-    if (m_playing && !m_filmTextures.empty())
+    int layer = -1;
+    if (m_playing && m_streaming)
+    {
+        layer = m_filmStream.layerOfFrame(m_currentFrame);
+    }
+    else if (m_playing && !m_filmTextures.empty())
     {
-        tex = m_filmTextures[m_currentFrame];
+        tex = frameTexture(m_currentFrame);
     }
     
     glActiveTexture(GL_TEXTURE0);
     glBindTexture(GL_TEXTURE_2D, tex);
     m_shader->setInt("uTex", 0);
     
+    glActiveTexture(GL_TEXTURE1);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, layer >= 0 ? m_filmStream.getTextureArray() : 0);
+    m_shader->setInt("uFilmFrames", 1);
+    m_shader->setInt("uUseArray", layer >= 0 ? 1 : 0);
+    m_shader->setFloat("uLayer", (float)layer);
+    glActiveTexture(GL_TEXTURE0);
+    
     
     m_shader->setInt("uForceSolid", 0);
     m_shader->setInt("uDebugUV", 0);
@@ -239,3 +405,4 @@ void Screen::draw(const glm::mat4& view, const glm::mat4& projection)
     
     glEnable(GL_CULL_FACE);
 }
+#endif
@@ -1,39 +1,35 @@
 ﻿#include "../Header/SeatGrid.h"
-#include "../Header/DebugCube.h"
-#include "../Header/SeatMesh.h"
-#include "../Header/Light.h"
-#include "../Shader.h"
-#include <glm/gtc/matrix_transform.hpp>
+#include "../Header/BitScan.h"
+#include <algorithm>
+
+namespace
+{
+    
+    uint64_t bitsFrom(const uint64_t* words, int wordCount, int word, int shift)
+    {
+        uint64_t bits = words[word] >> shift;
+        if (shift > 0 && word + 1 < wordCount)
+            bits |= words[word + 1] << (64 - shift);
+        return bits;
+    }
+}
 
 SeatGrid::SeatGrid()
-    : m_cubeMesh(nullptr)
-    , m_seatMesh(nullptr)
-    , m_origin(0.0f)
-    , m_seatSpacingX(1.0f)
-    , m_seatSpacingZ(1.2f)
-    , m_rowElevationStep(0.3f)
-    , m_seatHalfExtents(0.5f, 0.55f, 0.5f)  
+    : m_seatHalfExtents(0.5f, 0.55f, 0.5f)  
+    , m_layoutVersion(0)
+    , m_stateVersion(0)
+    , m_wordsPerRow(0)
 {
+    m_stateCounts[0] = m_stateCounts[1] = m_stateCounts[2] = 0;
 }
 
 SeatGrid::~SeatGrid()
 {
 }
 
-void SeatGrid::init(
-    DebugCube* cubeMesh,
-    SeatMesh* seatMesh,
-    const glm::vec3& origin,
-    float seatSpacingX,
-    float seatSpacingZ,
-    float rowElevationStep)
+void SeatGrid::init(const SeatLayout& layout)
 {
-    m_cubeMesh = cubeMesh;
-    m_seatMesh = seatMesh;
-    m_origin = origin;
-    m_seatSpacingX = seatSpacingX;
-    m_seatSpacingZ = seatSpacingZ;
-    m_rowElevationStep = rowElevationStep;
+    m_layout = layout;
     
     
     
@@ -49,10 +45,10 @@ void SeatGrid::init(
 void SeatGrid::createPlatforms()
 {
     m_platforms.clear();
-    m_platforms.reserve(ROWS);
+    m_platforms.reserve(m_layout.rows);
     
     
-    const float platformWidth = (COLS * m_seatSpacingX) + 4.0f;  
+    const float platformWidth = (m_layout.cols * m_layout.seatSpacingX) + m_layout.totalAisleWidth() + 1.0f;  
     const float walkingSpace = 1.0f;    
     const float seatDepth = m_seatHalfExtents.z * 2.0f;  
     const float platformDepth = seatDepth + walkingSpace * 2.0f;  
@@ -60,20 +56,20 @@ void SeatGrid::createPlatforms()
     const float floorY = 0.5f;  
     
     
-    for (int row = 0; row < ROWS; ++row)
+    for (int row = 0; row < m_layout.rows; ++row)
     {
         
-        float platformTopY = m_origin.y + row * m_rowElevationStep;
+        float platformTopY = m_layout.origin.y + row * m_layout.rowElevationStep;
         
         
         float platformHeight = platformTopY - floorY + 0.1f;  
         
         
-        float platformZ = m_origin.z + row * m_seatSpacingZ;
+        float platformZ = m_layout.origin.z + row * m_layout.seatSpacingZ;
         
         
         glm::vec3 platformPos(
-            m_origin.x,  
+            m_layout.origin.x,  
             floorY + platformHeight * 0.5f,  
             platformZ  
         );
@@ -86,134 +82,174 @@ void SeatGrid::createPlatforms()
 
 void SeatGrid::createSeats()
 {
+    const int rows = m_layout.rows;
+    const int cols = m_layout.cols;
+    const int seatCount = rows * cols;
     
+    m_seatPositions.resize(seatCount);
+    m_seatBounds.resize(seatCount);
+    m_seatStates.assign(seatCount, SeatState::Free);
+    m_seatSections.resize(seatCount);
     
     
+    std::vector<float> columnX(cols);
+    std::vector<int> columnSection(cols);
+    for (int col = 0; col < cols; ++col)
+    {
+        columnX[col] = m_layout.origin.x + (col - cols / 2.0f + 0.5f) * m_layout.seatSpacingX +
+                       m_layout.aisleOffsetForColumn(col);
+        columnSection[col] = m_layout.sectionOfColumn(col);
+    }
     
-    const float walkingSpace = 1.0f;  
-    const float seatOffsetZ = 0.0f;  
-    
-    for (int row = 0; row < ROWS; ++row)
+    for (int row = 0; row < rows; ++row)
     {
         
         const StepPlatform& platform = m_platforms[row];
         
         
         float platformTopY = platform.position.y + platform.size.y * 0.5f;
+        float rowZ = m_layout.origin.z + row * m_layout.seatSpacingZ;
         
-        for (int col = 0; col < COLS; ++col)
+        for (int col = 0; col < cols; ++col)
         {
+            int index = row * cols + col;
             
-            glm::vec3 position;
-            
+            glm::vec3 position(columnX[col], platformTopY + m_seatHalfExtents.y, rowZ);
             
-            
-            
-            float xOffset = (col < 5) ? -1.5f : 1.5f;
-            
-            position.x = m_origin.x + (col - COLS / 2.0f + 0.5f) * m_seatSpacingX + xOffset;
-            position.z = m_origin.z + row * m_seatSpacingZ + seatOffsetZ;
-            
-            
-            position.y = platformTopY + m_seatHalfExtents.y;
-            
-            
-            AABB bounds(
-                position - m_seatHalfExtents,
-                position + m_seatHalfExtents
-            );
-            
-            
-            m_seats[row][col] = Seat(row, col, position, bounds);
+            m_seatPositions[index] = position;
+            m_seatBounds[index] = AABB(position - m_seatHalfExtents, position + m_seatHalfExtents);
+            m_seatSections[index] = columnSection[col];
         }
     }
+    
+    rebuildOccupancy();
+    
+    m_layoutVersion++;
+    m_stateVersion++;
 }
 
-void SeatGrid::draw(Shader* phongShader, const glm::mat4& view, const glm::mat4& projection, const glm::vec3& viewPos)
+int SeatGrid::seatIndex(int row, int col) const
 {
-    if (!m_cubeMesh || !phongShader)
-        return;
-    
-    phongShader->use();
-    phongShader->setMat4("view", view);
-    phongShader->setMat4("projection", projection);
-    phongShader->setVec3("viewPos", viewPos);
+    if (row < 0 || row >= m_layout.rows || col < 0 || col >= m_layout.cols)
+        return -1;
     
+    return row * m_layout.cols + col;
+}
+
+void SeatGrid::setSeatState(int index, SeatState state)
+{
+    if (index < 0 || index >= getSeatCount() || m_seatStates[index] == state)
+        return;
     
-    phongShader->setVec3("lightPos", glm::vec3(0.0f, 4.0f, 0.0f));
-    phongShader->setVec3("lightColor", glm::vec3(1.0f, 0.95f, 0.85f));
-    phongShader->setFloat("lightIntensity", 5.0f);
-    glUniform1i(glGetUniformLocation(phongShader->ID, "lightEnabled"), 1);
-    
+    SeatState previous = m_seatStates[index];
+    m_seatStates[index] = state;
+    m_stateVersion++;
     
-    const glm::vec3 platformColor(0.35f, 0.3f, 0.25f);  
+    --m_stateCounts[(int)previous];
+    ++m_stateCounts[(int)state];
     
-    for (const auto& platform : m_platforms)
+    int row = index / m_layout.cols;
+    int col = index % m_layout.cols;
+    uint64_t& word = m_freeBits[row * m_wordsPerRow + col / 64];
+    uint64_t bit = 1ull << (col % 64);
+    if (state == SeatState::Free)
     {
-        glm::mat4 model = glm::mat4(1.0f);
-        model = glm::translate(model, platform.position);
-        model = glm::scale(model, platform.size);
-        
-        phongShader->setMat4("model", model);
-        phongShader->setVec3("uBaseColor", platformColor);
-        
-        m_cubeMesh->draw();
+        word |= bit;
+        ++m_rowFreeCounts[row];
+    }
+    else if (previous == SeatState::Free)
+    {
+        word &= ~bit;
+        --m_rowFreeCounts[row];
     }
+}
+
+void SeatGrid::resetAllSeats()
+{
+    if (m_stateCounts[(int)SeatState::Free] == getSeatCount())
+        return;
+    
+    std::fill(m_seatStates.begin(), m_seatStates.end(), SeatState::Free);
+    m_stateVersion++;
+    rebuildOccupancy();
+}
+
+void SeatGrid::rebuildOccupancy()
+{
+    const int rows = m_layout.rows;
+    const int cols = m_layout.cols;
+    
+    m_wordsPerRow = (cols + 63) / 64;
+    m_freeBits.assign(rows * m_wordsPerRow, 0);
+    m_rowFreeCounts.assign(rows, 0);
+    m_stateCounts[0] = m_stateCounts[1] = m_stateCounts[2] = 0;
     
     
-    for (int row = 0; row < ROWS; ++row)
+    for (int row = 0; row < rows; ++row)
     {
-        for (int col = 0; col < COLS; ++col)
+        for (int col = 0; col < cols; ++col)
         {
-            const Seat& seat = m_seats[row][col];
-            
-            
-            glm::vec3 seatColor;
-            switch (seat.state)
+            SeatState state = m_seatStates[row * cols + col];
+            ++m_stateCounts[(int)state];
+            if (state == SeatState::Free)
             {
-                case SeatState::Free:
-                    seatColor = glm::vec3(0.2f, 0.7f, 0.2f);  
-                    break;
-                case SeatState::Reserved:
-                    seatColor = glm::vec3(0.9f, 0.9f, 0.2f);  
-                    break;
-                case SeatState::Purchased:
-                    seatColor = glm::vec3(0.8f, 0.2f, 0.2f);  
-                    break;
+                m_freeBits[row * m_wordsPerRow + col / 64] |= 1ull << (col % 64);
+                ++m_rowFreeCounts[row];
             }
-            
-            
-            glm::mat4 model = glm::mat4(1.0f);
-            model = glm::translate(model, seat.position);
-            model = glm::rotate(model, glm::pi<float>(), glm::vec3(0.0f, 1.0f, 0.0f));  
-            model = glm::scale(model, m_seatHalfExtents * 2.0f);  
-            
-            phongShader->setMat4("model", model);
-            phongShader->setVec3("uBaseColor", seatColor);
-            
-            
-            if (m_seatMesh)
-                m_seatMesh->draw();
-            else
-                m_cubeMesh->draw();
         }
     }
 }
 
-Seat* SeatGrid::getSeat(int row, int col)
+int SeatGrid::countOccupiedSeats() const
 {
-    if (row < 0 || row >= ROWS || col < 0 || col >= COLS)
-        return nullptr;
+    return m_stateCounts[(int)SeatState::Reserved] + m_stateCounts[(int)SeatState::Purchased];
+}
+
+void SeatGrid::getOccupiedSeats(std::vector<int>& seats) const
+{
+    seats.clear();
+    seats.reserve(countOccupiedSeats());
     
-    return &m_seats[row][col];
+    const int cols = m_layout.cols;
+    for (int row = 0; row < m_layout.rows; ++row)
+    {
+        if (m_rowFreeCounts[row] == cols)
+            continue;
+        
+        for (int w = 0; w < m_wordsPerRow; ++w)
+        {
+            
+            int validBits = std::min(64, cols - w * 64);
+            uint64_t validMask = validBits == 64 ? ~0ull : (1ull << validBits) - 1;
+            uint64_t occupied = ~m_freeBits[row * m_wordsPerRow + w] & validMask;
+            while (occupied)
+            {
+                seats.push_back(row * cols + w * 64 + lowestBit(occupied));
+                occupied &= occupied - 1;
+            }
+        }
+    }
 }
 
-const Seat* SeatGrid::getSeat(int row, int col) const
+int SeatGrid::findFreeRun(int row, int length) const
 {
-    if (row < 0 || row >= ROWS || col < 0 || col >= COLS)
-        return nullptr;
+    if (length < 1 || length > 64 || length > m_layout.cols || m_rowFreeCounts[row] < length)
+        return -1;
+    
+    
+    
+    const uint64_t* words = &m_freeBits[row * m_wordsPerRow];
+    for (int w = m_wordsPerRow - 1; w >= 0; --w)
+    {
+        uint64_t runStarts = words[w];
+        for (int shift = 1; shift < length && runStarts; ++shift)
+            runStarts &= bitsFrom(words, m_wordsPerRow, w, shift);
+        
+        if (runStarts)
+            return w * 64 + highestBit(runStarts);
+    }
     
-    return &m_seats[row][col];
+    return -1;
 }
 
 bool SeatGrid::purchaseAdjacent(int N)
@@ -222,7 +258,8 @@ bool SeatGrid::purchaseAdjacent(int N)
     if (N < 1 || N > 9)
         return false;  
     
-    if (N > COLS)
+    const int cols = m_layout.cols;
+    if (N > cols)
         return false;  
     
     
@@ -230,41 +267,19 @@ bool SeatGrid::purchaseAdjacent(int N)
     
     
     
-    for (int row = ROWS - 1; row >= 0; --row)
+    for (int row = m_layout.rows - 1; row >= 0; --row)
     {
         
+        int start = findFreeRun(row, N);
+        if (start < 0)
+            continue;
         
-        
-        
-        for (int col = COLS - 1; col >= N - 1; --col)
+        for (int i = 0; i < N; ++i)
         {
-            
-            bool allFree = true;
-            
-            for (int i = 0; i < N; ++i)
-            {
-                int checkCol = col - i;
-                if (m_seats[row][checkCol].state != SeatState::Free)
-                {
-                    allFree = false;
-                    break;
-                }
-            }
-            
-            
-            if (allFree)
-            {
-                
-                for (int i = 0; i < N; ++i)
-                {
-                    int purchaseCol = col - i;
-                    m_seats[row][purchaseCol].state = SeatState::Purchased;
-                }
-                
-                
-                return true;
-            }
+            setSeatState(row * cols + start + i, SeatState::Purchased);
         }
+        
+        return true;
     }
     
     
@@ -0,0 +1,129 @@
+﻿#include "../Header/SeatLayout.h"
+#include "../Header/Log.h"
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+
+SeatLayout::SeatLayout()
+    : rows(5)
+    , cols(10)
+    , aisleColumns(1, 5)
+    , aisleWidth(3.0f)
+    , origin(0.0f, 1.0f, 2.0f)
+    , seatSpacingX(1.0f)
+    , seatSpacingZ(1.2f)
+    , rowElevationStep(0.3f)
+{
+}
+
+bool SeatLayout::loadFromFile(const std::string& path, SeatLayout& layout)
+{
+    std::ifstream file(path);
+    if (!file.is_open())
+    {
+        LOG_WARNING("[LAYOUT] Cannot open seat layout: " + path);
+        return false;
+    }
+    
+    SeatLayout parsed;
+    parsed.aisleColumns.clear();
+    
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(file, line))
+    {
+        ++lineNumber;
+        
+        size_t comment = line.find('#');
+        if (comment != std::string::npos)
+            line.erase(comment);
+        
+        std::istringstream iss(line);
+        std::string key;
+        if (!(iss >> key))
+            continue;
+        
+        bool ok = true;
+        if (key == "rows")
+        {
+            ok = static_cast<bool>(iss >> parsed.rows);
+        }
+        else if (key == "cols")
+        {
+            ok = static_cast<bool>(iss >> parsed.cols);
+        }
+        else if (key == "aisle")
+        {
+            int col;
+            while (iss >> col)
+                parsed.aisleColumns.push_back(col);
+        }
+        else if (key == "aisle_width")
+        {
+            ok = static_cast<bool>(iss >> parsed.aisleWidth);
+        }
+        else if (key == "origin")
+        {
+            ok = static_cast<bool>(iss >> parsed.origin.x >> parsed.origin.y >> parsed.origin.z);
+        }
+        else if (key == "spacing")
+        {
+            ok = static_cast<bool>(iss >> parsed.seatSpacingX >> parsed.seatSpacingZ);
+        }
+        else if (key == "row_elevation")
+        {
+            ok = static_cast<bool>(iss >> parsed.rowElevationStep);
+        }
+        else
+        {
+            LOG_WARNING("[LAYOUT] " + path + ":" + std::to_string(lineNumber) + " unknown key '" + key + "'");
+        }
+        
+        if (!ok)
+        {
+            LOG_ERROR("[LAYOUT] " + path + ":" + std::to_string(lineNumber) + " invalid value for '" + key + "'");
+            return false;
+        }
+    }
+    
+    std::sort(parsed.aisleColumns.begin(), parsed.aisleColumns.end());
+    parsed.aisleColumns.erase(std::unique(parsed.aisleColumns.begin(), parsed.aisleColumns.end()),
+                              parsed.aisleColumns.end());
+    
+    if (!parsed.isValid())
+    {
+        LOG_ERROR("[LAYOUT] Invalid seat layout in " + path);
+        return false;
+    }
+    
+    layout = parsed;
+    LOG_INFO("[LAYOUT] Loaded " + path + ": " + std::to_string(layout.rows) + "x" +
+             std::to_string(layout.cols) + " seats, " + std::to_string(layout.sectionCount()) + " sections");
+    return true;
+}
+
+bool SeatLayout::isValid() const
+{
+    if (rows <= 0 || cols <= 0)
+        return false;
+    
+    for (int col : aisleColumns)
+    {
+        if (col <= 0 || col >= cols)
+            return false;
+    }
+    
+    return seatSpacingX > 0.0f && seatSpacingZ > 0.0f && aisleWidth >= 0.0f;
+}
+
+int SeatLayout::sectionOfColumn(int col) const
+{
+    
+    return (int)(std::upper_bound(aisleColumns.begin(), aisleColumns.end(), col) - aisleColumns.begin());
+}
+
+float SeatLayout::aisleOffsetForColumn(int col) const
+{
+    
+    return sectionOfColumn(col) * aisleWidth - totalAisleWidth() * 0.5f;
+}
@@ -0,0 +1,207 @@
+﻿#include "../Header/SeatRenderer.h"
+#include "../Header/SeatGrid.h"
+#include "../Header/DebugCube.h"
+#include "../Header/SeatMesh.h"
+#include "../Shader.h"
+#include <GL/glew.h>
+#include <glm/gtc/matrix_transform.hpp>
+#include <cstddef>
+
+SeatRenderer::SeatRenderer()
+    : m_cubeMesh(nullptr)
+    , m_seatMesh(nullptr)
+    , m_instancedShader(nullptr)
+    , m_instancingEnabled(true)
+    , m_instanceBuffersCreated(false)
+    , m_seatInstancesDirty(true)
+    , m_seatInstanceVAO(0)
+    , m_seatInstanceVBO(0)
+    , m_synced(false)
+    , m_layoutVersion(0)
+    , m_stateVersion(0)
+{
+}
+
+SeatRenderer::~SeatRenderer()
+{
+    cleanup();
+}
+
+void SeatRenderer::init(DebugCube* cubeMesh, SeatMesh* seatMesh)
+{
+    m_cubeMesh = cubeMesh;
+    m_seatMesh = seatMesh;
+}
+
+void SeatRenderer::cleanup()
+{
+    releaseInstanceBuffers();
+    m_seatInstances.clear();
+    m_synced = false;
+}
+
+void SeatRenderer::syncInstances(const SeatGrid& grid)
+{
+    bool layoutChanged = !m_synced || grid.getLayoutVersion() != m_layoutVersion;
+    if (!layoutChanged && grid.getStateVersion() == m_stateVersion)
+        return;
+    
+    const std::vector<SeatState>& states = grid.getSeatStates();
+    int seatCount = grid.getSeatCount();
+    
+    if (layoutChanged)
+    {
+        
+        releaseInstanceBuffers();
+        m_seatInstances.resize(seatCount);
+        for (int i = 0; i < seatCount; ++i)
+        {
+            m_seatInstances[i].model = seatModelMatrix(grid.getSeatPosition(i), grid.getSeatHalfExtents());
+        }
+    }
+    
+    for (int i = 0; i < seatCount; ++i)
+    {
+        m_seatInstances[i].color = glm::vec4(stateColor(states[i]), 1.0f);
+    }
+    
+    m_synced = true;
+    m_layoutVersion = grid.getLayoutVersion();
+    m_stateVersion = grid.getStateVersion();
+    m_seatInstancesDirty = true;
+}
+
+glm::mat4 SeatRenderer::seatModelMatrix(const glm::vec3& position, const glm::vec3& halfExtents)
+{
+    glm::mat4 model = glm::mat4(1.0f);
+    model = glm::translate(model, position);
+    model = glm::rotate(model, glm::pi<float>(), glm::vec3(0.0f, 1.0f, 0.0f));  
+    model = glm::scale(model, halfExtents * 2.0f);  
+    return model;
+}
+
+glm::vec3 SeatRenderer::stateColor(SeatState state)
+{
+    switch (state)
+    {
+        case SeatState::Reserved:
+            return glm::vec3(0.9f, 0.9f, 0.2f);  
+        case SeatState::Purchased:
+            return glm::vec3(0.8f, 0.2f, 0.2f);  
+        case SeatState::Free:
+        default:
+            return glm::vec3(0.2f, 0.7f, 0.2f);  
+    }
+}
+
+void SeatRenderer::draw(const SeatGrid& grid, Shader* phongShader)
+{
+    if (!m_cubeMesh || !phongShader)
+        return;
+    
+    syncInstances(grid);
+    
+    if (m_instancingEnabled && m_instancedShader)
+    {
+        drawInstanced();
+        return;
+    }
+    
+    phongShader->use();
+    GLint modelLoc = phongShader->uniformLocation("model");
+    GLint colorLoc = phongShader->uniformLocation("uBaseColor");
+    
+    for (const SeatInstance& instance : m_seatInstances)
+    {
+        phongShader->setMat4(modelLoc, instance.model);
+        phongShader->setVec3(colorLoc, glm::vec3(instance.color));
+        
+        
+        if (m_seatMesh)
+            m_seatMesh->draw();
+        else
+            m_cubeMesh->draw();
+    }
+}
+
+void SeatRenderer::drawInstanced()
+{
+    if (m_seatInstances.empty())
+        return;
+    
+    if (!m_instanceBuffersCreated)
+        createInstanceBuffers();
+    
+    if (m_seatInstancesDirty)
+    {
+        glBindBuffer(GL_ARRAY_BUFFER, m_seatInstanceVBO);
+        glBufferSubData(GL_ARRAY_BUFFER, 0,
+                        (GLsizeiptr)(m_seatInstances.size() * sizeof(SeatInstance)),
+                        m_seatInstances.data());
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+        m_seatInstancesDirty = false;
+    }
+    
+    m_instancedShader->use();
+    
+    glBindVertexArray(m_seatInstanceVAO);
+    if (m_seatMesh)
+        glDrawElementsInstanced(GL_TRIANGLES, m_seatMesh->getIndexCount(), GL_UNSIGNED_INT,
+                                (void*)0, (GLsizei)m_seatInstances.size());
+    else
+        glDrawArraysInstanced(GL_TRIANGLES, 0, m_cubeMesh->getVertexCount(), (GLsizei)m_seatInstances.size());
+    
+    glBindVertexArray(0);
+}
+
+void SeatRenderer::createInstanceBuffers()
+{
+    glGenVertexArrays(1, &m_seatInstanceVAO);
+    glGenBuffers(1, &m_seatInstanceVBO);
+    glBindVertexArray(m_seatInstanceVAO);
+    if (m_seatMesh)
+        m_seatMesh->bindVertexAttributes();
+    else
+        m_cubeMesh->bindVertexAttributes();
+    glBindBuffer(GL_ARRAY_BUFFER, m_seatInstanceVBO);
+    glBufferData(GL_ARRAY_BUFFER,
+                 (GLsizeiptr)(m_seatInstances.size() * sizeof(SeatInstance)),
+                 m_seatInstances.data(), GL_DYNAMIC_DRAW);
+    setupInstanceAttributes();
+    
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    
+    m_instanceBuffersCreated = true;
+    m_seatInstancesDirty = false;
+}
+
+void SeatRenderer::setupInstanceAttributes() const
+{
+    
+    for (int column = 0; column < 4; ++column)
+    {
+        GLuint location = 2 + column;
+        glVertexAttribPointer(location, 4, GL_FLOAT, GL_FALSE, sizeof(SeatInstance),
+                              (void*)(offsetof(SeatInstance, model) + column * sizeof(glm::vec4)));
+        glEnableVertexAttribArray(location);
+        glVertexAttribDivisor(location, 1);
+    }
+    
+    glVertexAttribPointer(6, 3, GL_FLOAT, GL_FALSE, sizeof(SeatInstance),
+                          (void*)offsetof(SeatInstance, color));
+    glEnableVertexAttribArray(6);
+    glVertexAttribDivisor(6, 1);
+}
+
+void SeatRenderer::releaseInstanceBuffers()
+{
+    if (!m_instanceBuffersCreated)
+        return;
+    
+    glDeleteVertexArrays(1, &m_seatInstanceVAO);
+    glDeleteBuffers(1, &m_seatInstanceVBO);
+    m_seatInstanceVAO = 0;
+    m_seatInstanceVBO = 0;
+    m_instanceBuffersCreated = false;
+}
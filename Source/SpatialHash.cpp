@@ -0,0 +1,59 @@
+﻿#include "../Header/SpatialHash.h"
+
+SpatialHash::SpatialHash()
+    : m_cellSize(1.0f)
+    , m_inverseCellSize(1.0f)
+    , m_bucketMask(0)
+{
+}
+
+void SpatialHash::setCellSize(float cellSize)
+{
+    if (cellSize <= 0.0f)
+        return;
+
+    m_cellSize = cellSize;
+    m_inverseCellSize = 1.0f / cellSize;
+    clear();
+}
+
+void SpatialHash::build(const std::vector<glm::vec3>& positions, const std::vector<int>& indices)
+{
+    clear();
+    if (indices.empty())
+        return;
+
+    
+    uint32_t bucketCount = 64;
+    while (bucketCount < indices.size() * 2)
+        bucketCount <<= 1;
+    m_bucketMask = bucketCount - 1;
+
+    
+    m_bucketStart.assign(bucketCount + 1, 0);
+    m_entryBuckets.resize(indices.size());
+    for (size_t j = 0; j < indices.size(); ++j)
+    {
+        const glm::vec3& p = positions[indices[j]];
+        uint32_t bucket = bucketOf(cellCoord(p.x), cellCoord(p.z));
+        m_entryBuckets[j] = bucket;
+        ++m_bucketStart[bucket + 1];
+    }
+
+    for (uint32_t b = 0; b < bucketCount; ++b)
+        m_bucketStart[b + 1] += m_bucketStart[b];
+
+    m_cursor.assign(m_bucketStart.begin(), m_bucketStart.end() - 1);
+    m_entries.resize(indices.size());
+    for (size_t j = 0; j < indices.size(); ++j)
+        m_entries[m_cursor[m_entryBuckets[j]]++] = indices[j];
+}
+
+void SpatialHash::clear()
+{
+    m_bucketStart.clear();
+    m_entryBuckets.clear();
+    m_cursor.clear();
+    m_entries.clear();
+    m_bucketMask = 0;
+}
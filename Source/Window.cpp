@@ -7,6 +7,7 @@ Window::Window()
     : m_window(nullptr)
     , m_width(0)
     , m_height(0)
+    , m_refreshRate(0)
 {
 }
 
@@ -37,6 +38,7 @@ bool Window::init()
 
     m_width = videoMode->width;
     m_height = videoMode->height;
+    m_refreshRate = videoMode->refreshRate;
 
     
     glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
@@ -120,6 +122,15 @@ void Window::swapBuffers()
     }
 }
 
+void Window::setVSync(bool enabled)
+{
+    if (m_window)
+    {
+        glfwSwapInterval(enabled ? 1 : 0);
+        LOG_INFO("VSync: " + std::string(enabled ? "ON" : "OFF") + " (" + std::to_string(m_refreshRate) + " Hz)");
+    }
+}
+
 void Window::keyCallback(GLFWwindow* window, int key, int scancode, int action, int mods)
 {
     (void)scancode;
@@ -0,0 +1,127 @@
+﻿#include "../Header/Crowd.h"
+#include "../Header/HallNavigation.h"
+#include "../Header/SeatLayout.h"
+#include <cstdio>
+#include <vector>
+
+struct TestHall
+{
+    SeatLayout layout;
+    AABB floor;
+    glm::vec3 door;
+    std::vector<glm::vec3> seatPositions;
+    std::vector<AABB> seatBounds;
+};
+
+static TestHall createHall(int rows, int cols)
+{
+    TestHall hall;
+    SeatLayout& layout = hall.layout;
+    layout.rows = rows;
+    layout.cols = cols;
+    layout.aisleColumns.assign(1, cols / 2);
+    layout.origin = glm::vec3(0.0f, 0.5f, 0.0f);
+
+    glm::vec3 halfExtents(0.5f, 0.55f, 0.5f);
+    for (int row = 0; row < layout.rows; ++row)
+    {
+        for (int col = 0; col < layout.cols; ++col)
+        {
+            glm::vec3 seat(layout.origin.x + (col - layout.cols / 2.0f + 0.5f) * layout.seatSpacingX +
+                           layout.aisleOffsetForColumn(col),
+                           layout.origin.y,
+                           layout.origin.z + row * layout.seatSpacingZ);
+            hall.seatPositions.push_back(seat);
+            hall.seatBounds.push_back(AABB(seat - halfExtents, seat + halfExtents));
+        }
+    }
+
+    float halfWidth = (layout.cols * layout.seatSpacingX + layout.totalAisleWidth()) * 0.5f + 3.0f;
+    float depth = layout.rows * layout.seatSpacingZ + 3.0f;
+    hall.floor = AABB(glm::vec3(-halfWidth, 0.4f, -8.0f), glm::vec3(halfWidth, 0.5f, depth));
+    hall.door = glm::vec3(-halfWidth + 1.0f, 0.5f, -7.0f);
+    return hall;
+}
+
+static int s_failures = 0;
+
+static void check(bool condition, const char* what)
+{
+    if (!condition)
+    {
+        std::printf("FAIL: %s\n", what);
+        ++s_failures;
+    }
+}
+
+static void testAgentsCrossingInTheAisle()
+{
+    TestHall hall = createHall(5, 40);
+    HallNavigation navigation;
+    std::vector<AABB> surfaces;
+    bool built = navigation.build(hall.floor, hall.layout, hall.seatPositions, hall.seatBounds, surfaces, hall.door);
+    check(built, "navigation builds for a 5x40 hall");
+    if (!built)
+        return;
+
+    Crowd crowd;
+    crowd.setNavigation(&navigation);
+    
+    int seatCount = (int)hall.seatPositions.size();
+    int half = seatCount / 2;
+    std::vector<int> order(seatCount);
+    for (int i = 0; i < seatCount; ++i)
+        order[i] = (i * 37) % seatCount;
+
+    const float dt = 1.0f / 60.0f;
+    const int maxSteps = 60 * 60 * 20;
+
+    for (int i = 0; i < half; ++i)
+        crowd.queueSpawn(hall.door, hall.seatPositions[order[i]], glm::vec3(0.5f), 0);
+
+    bool firstHalfLeaving = false;
+    bool everyoneLeaving = false;
+    int step = 0;
+
+    for (; step < maxSteps; ++step)
+    {
+        crowd.update(dt);
+        
+        if (!firstHalfLeaving && crowd.allSeated())
+        {
+            crowd.startExiting();
+            for (int i = half; i < seatCount; ++i)
+                crowd.queueSpawn(hall.door, hall.seatPositions[order[i]], glm::vec3(0.5f), 0);
+            firstHalfLeaving = true;
+        }
+
+        if (firstHalfLeaving && !everyoneLeaving && crowd.getQueuedCount() == 0 &&
+            crowd.getSeatedCount() == seatCount - half && crowd.getExitedCount() == half)
+        {
+            crowd.startExiting();
+            everyoneLeaving = true;
+        }
+
+        if (everyoneLeaving && crowd.allExited())
+            break;
+    }
+
+    check(firstHalfLeaving, "first half of the audience is seated");
+    check(everyoneLeaving, "second half is seated while the first half leaves through the aisle");
+    check(everyoneLeaving && crowd.allExited(), "every agent reaches the door after the show");
+    std::printf("crowd crossing: %d agents, %.1f s simulated, seated %d, exited %d\n",
+                seatCount, step * dt, crowd.getSeatedCount(), crowd.getExitedCount());
+}
+
+int main()
+{
+    testAgentsCrossingInTheAisle();
+
+    if (s_failures > 0)
+    {
+        std::printf("%d check(s) failed\n", s_failures);
+        return 1;
+    }
+    std::printf("All crowd tests passed\n");
+    return 0;
+}